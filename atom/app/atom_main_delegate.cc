@@ -13,6 +13,7 @@
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/relauncher.h"
 #include "atom/common/google_api_key.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/utility/atom_content_utility_client.h"
 #include "base/base_switches.h"
 #include "base/command_line.h"
@@ -26,6 +27,7 @@
 #include "brightray/browser/brightray_paths.h"
 #include "brightray/common/application_info.h"
 #include "browser/brightray_paths.h"
+#include "chrome/browser/process_singleton.h"
 #include "chrome/common/chrome_constants.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
@@ -194,6 +196,7 @@ AtomMainDelegate::~AtomMainDelegate() {
 }
 
 bool AtomMainDelegate::BasicStartupComplete(int* exit_code) {
+  StartupTimeline::ScopedPhase phase("BasicStartupComplete");
   auto command_line = base::CommandLine::ForCurrentProcess();
 
 #if defined(OS_MACOSX)
@@ -352,6 +355,16 @@ int AtomMainDelegate::RunProcess(
         return kMainFunctions[i].function(main_function_params);
     }
 
+#if defined(OS_POSIX) && !defined(OS_ANDROID)
+    // Hand the command line to a running single instance app before paying
+    // for the browser, V8 and node startup.
+    base::FilePath user_data_dir;
+    if (process_type.empty() &&
+        PathService::Get(brightray::DIR_USER_DATA, &user_data_dir) &&
+        ProcessSingleton::NotifyRunningInstance(user_data_dir))
+      return 0;
+#endif
+
     return -1;
 }
 
@@ -4,6 +4,8 @@
 
 #include "atom/browser/api/atom_api_app.h"
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,8 +17,11 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/idle_gc_scheduler.h"
+#include "atom/browser/jank_detector.h"
 #include "atom/browser/login_handler.h"
 #include "atom/browser/net/atom_network_delegate.h"
+#include "atom/browser/process_metrics_sampler.h"
 #include "atom/browser/relauncher.h"
 #include "atom/common/atom_command_line.h"
 #include "atom/common/native_mate_converters/callback.h"
@@ -28,13 +33,16 @@
 #include "atom/common/node_includes.h"
 #include "atom/common/options_switches.h"
 #include "atom/common/pepper_flash_util.h"
+#include "atom/common/startup_timeline.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/strings/string_util.h"
+#include "base/sys_info.h"
 #include "brave/browser/brave_content_browser_client.h"
+#include "brave/common/workers/v8_worker_pool.h"
 #include "brave/common/workers/v8_worker_thread.h"
 #include "brave/common/workers/worker_bindings.h"
 #include "brightray/browser/brightray_paths.h"
@@ -376,6 +384,57 @@ struct Converter<CertificateRequestResultType> {
   }
 };
 
+template<>
+struct Converter<atom::ProcessMetricsSampler::ProcessInfo> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const atom::ProcessMetricsSampler::ProcessInfo& val) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("pid", val.pid);
+    dict.Set("type", val.type);
+    dict.Set("webContentsIds", val.web_contents_ids);
+    dict.Set("tabIds", val.tab_ids);
+    dict.Set("cpuUsage", val.cpu_usage);
+    dict.Set("workingSetSize",
+             static_cast<double>(val.working_set_size >> 10));
+    dict.Set("privateBytes", static_cast<double>(val.private_bytes >> 10));
+    if (val.has_io_counters) {
+      mate::Dictionary io = mate::Dictionary::CreateEmpty(isolate);
+      const base::IoCounters& counters = val.io_counters;
+      io.Set("readOperationCount",
+             static_cast<double>(counters.ReadOperationCount));
+      io.Set("writeOperationCount",
+             static_cast<double>(counters.WriteOperationCount));
+      io.Set("otherOperationCount",
+             static_cast<double>(counters.OtherOperationCount));
+      io.Set("readTransferCount",
+             static_cast<double>(counters.ReadTransferCount));
+      io.Set("writeTransferCount",
+             static_cast<double>(counters.WriteTransferCount));
+      io.Set("otherTransferCount",
+             static_cast<double>(counters.OtherTransferCount));
+      dict.Set("ioCounters", io);
+    }
+    return dict.GetHandle();
+  }
+};
+
+template<>
+struct Converter<atom::JankDetector::LongTask> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const atom::JankDetector::LongTask& val) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("startTime", val.start_time.ToJsTime());
+    dict.Set("duration", val.duration.InMillisecondsF());
+    dict.Set("functionName", val.function_name);
+    dict.Set("fileName", val.file_name);
+    dict.Set("lineNumber", val.line_number);
+    dict.Set("nestingDepth", val.nesting_depth);
+    dict.Set("jsStack", val.js_stack);
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace mate
 
 
@@ -385,6 +444,10 @@ namespace api {
 
 namespace {
 
+// After a launch of another instance is handed to JS, the launches that
+// follow within this time are collected and handed to JS together.
+const int kSecondInstanceBatchDelayMs = 50;
+
 // Return the path constant from string.
 int GetPathConstant(const std::string& name) {
   if (name == "appData")
@@ -427,23 +490,6 @@ int GetPathConstant(const std::string& name) {
     return -1;
 }
 
-bool NotificationCallbackWrapper(
-    const ProcessSingleton::NotificationCallback& callback,
-    const base::CommandLine::StringVector& cmd,
-    const base::FilePath& cwd) {
-  // Make sure the callback is called after app gets ready.
-  if (Browser::Get()->is_ready()) {
-    callback.Run(cmd, cwd);
-  } else {
-    scoped_refptr<base::SingleThreadTaskRunner> task_runner(
-        base::ThreadTaskRunnerHandle::Get());
-    task_runner->PostTask(
-        FROM_HERE, base::Bind(base::IgnoreResult(callback), cmd, cwd));
-  }
-  // ProcessSingleton needs to know whether current process is quiting.
-  return !Browser::Get()->is_shutting_down();
-}
-
 void OnClientCertificateSelected(
     v8::Isolate* isolate,
     std::shared_ptr<content::ClientCertificateDelegate> delegate,
@@ -508,7 +554,7 @@ int ImportIntoCertStore(
 
 }  // namespace
 
-App::App(v8::Isolate* isolate) {
+App::App(v8::Isolate* isolate) : next_worker_pool_id_(0) {
   static_cast<brave::BraveContentBrowserClient*>(
     brave::BraveContentBrowserClient::Get())->set_delegate(this);
   Browser::Get()->AddObserver(this);
@@ -561,6 +607,7 @@ App::~App() {
   Browser::Get()->RemoveObserver(this);
   net::NetworkChangeNotifier::RemoveMaxBandwidthObserver(this);
   content::GpuDataManager::GetInstance()->RemoveObserver(this);
+  JankDetector::GetInstance()->Stop();
 }
 
 void App::OnBeforeQuit(bool* prevent_default) {
@@ -579,6 +626,7 @@ void App::OnQuit() {
   int exitCode = AtomBrowserMainParts::Get()->GetExitCode();
   Emit("quit", exitCode);
 
+  worker_pools_.clear();
   content::WorkerThreadRegistry::Instance()->PostTaskToAllThreads(
     base::Bind(&brave::V8WorkerThread::Shutdown));
 
@@ -608,6 +656,8 @@ void App::OnFinishLaunching(const base::DictionaryValue& launch_info) {
   // observer can't be added until after PostMainMessageLoopStart
   net::NetworkChangeNotifier::AddMaxBandwidthObserver(this);
   Emit("ready", launch_info);
+  // Launches that arrived before the app was ready.
+  OnSecondInstanceTimer();
 }
 
 void App::OnAccessibilitySupportChanged() {
@@ -752,15 +802,23 @@ void App::SetLocale(std::string locale) {
 }
 
 bool App::MakeSingleInstance(
-    const ProcessSingleton::NotificationCallback& callback) {
+    const ProcessSingleton::NotificationCallback& callback,
+    mate::Arguments* args) {
   base::ThreadRestrictions::SetIOAllowed(true);  // TODO(bridiver) ugh electron
   if (process_singleton_.get())
     return false;
 
+  bool fast_path = false;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("fastPath", &fast_path);
+
   base::FilePath user_dir;
   PathService::Get(brightray::DIR_USER_DATA, &user_dir);
+  single_instance_callback_ = callback;
   process_singleton_.reset(new ProcessSingleton(
-      user_dir, base::Bind(NotificationCallbackWrapper, callback)));
+      user_dir,
+      base::Bind(&App::OnSecondInstance, base::Unretained(this))));
 
   switch (process_singleton_->NotifyOtherProcessOrCreate()) {
     case ProcessSingleton::NotifyResult::LOCK_ERROR:
@@ -770,10 +828,58 @@ bool App::MakeSingleInstance(
       return true;
     case ProcessSingleton::NotifyResult::PROCESS_NONE:
     default:  // Shouldn't be needed, but VS warns if it is not there.
+#if defined(OS_POSIX)
+      if (fast_path)
+        process_singleton_->EnableFastPath();
+#endif
       return false;
   }
 }
 
+bool App::OnSecondInstance(const base::CommandLine::StringVector& argv,
+                           const base::FilePath& working_directory) {
+  pending_second_instances_.push_back(std::make_pair(argv, working_directory));
+  // The first launch of a burst is handed to JS at once, the ones that follow
+  // are collected until the timer fires. Before the app is ready, launches
+  // wait for OnFinishLaunching.
+  if (Browser::Get()->is_ready() && !second_instance_timer_.IsRunning())
+    OnSecondInstanceTimer();
+  // ProcessSingleton needs to know whether current process is quiting.
+  return !Browser::Get()->is_shutting_down();
+}
+
+void App::OnSecondInstanceTimer() {
+  if (pending_second_instances_.empty())
+    return;
+  FlushSecondInstances();
+  second_instance_timer_.Start(
+      FROM_HERE,
+      base::TimeDelta::FromMilliseconds(kSecondInstanceBatchDelayMs),
+      base::Bind(&App::OnSecondInstanceTimer, base::Unretained(this)));
+}
+
+void App::FlushSecondInstances() {
+  if (pending_second_instances_.empty())
+    return;
+
+  std::vector<std::pair<base::CommandLine::StringVector, base::FilePath>>
+      launches;
+  launches.swap(pending_second_instances_);
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  std::vector<mate::Dictionary> launch_list;
+  for (const auto& launch : launches) {
+    if (!single_instance_callback_.is_null())
+      single_instance_callback_.Run(launch.first, launch.second);
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+    dict.Set("argv", launch.first);
+    dict.Set("workingDirectory", launch.second);
+    launch_list.push_back(dict);
+  }
+  Emit("second-instance", launch_list);
+}
+
 void App::ReleaseSingleInstance() {
   if (process_singleton_.get()) {
     process_singleton_->Cleanup();
@@ -832,8 +938,86 @@ bool App::IsAccessibilitySupportEnabled() {
   return ax_state->IsAccessibleBrowser();
 }
 
-void App::PostMessage(int worker_id, v8::Local<v8::Value> message) {
-  brave::WorkerBindings::OnMessage(isolate(), worker_id, message);
+v8::Local<v8::Value> App::GetStartupTimeline(v8::Isolate* isolate) {
+  return mate::ConvertToV8(isolate,
+                           *StartupTimeline::GetInstance()->ToValue());
+}
+
+void App::GetProcessMetrics(
+    const ProcessMetricsSampler::SampleCallback& callback) {
+  if (!process_metrics_sampler_)
+    process_metrics_sampler_.reset(new ProcessMetricsSampler);
+  process_metrics_sampler_->Sample(callback);
+}
+
+void App::StartProcessMetricsSampling(int interval_ms) {
+  if (!process_metrics_sampler_)
+    process_metrics_sampler_.reset(new ProcessMetricsSampler);
+  process_metrics_sampler_->Start(
+      base::TimeDelta::FromMilliseconds(std::max(interval_ms, 1000)),
+      base::Bind(&App::OnProcessMetrics, base::Unretained(this)));
+}
+
+void App::StopProcessMetricsSampling() {
+  if (process_metrics_sampler_)
+    process_metrics_sampler_->Stop();
+}
+
+void App::OnProcessMetrics(
+    const ProcessMetricsSampler::ProcessInfoList& processes) {
+  Emit("process-metrics", processes);
+}
+
+void App::StartJankDetector(mate::Arguments* args) {
+  int threshold_ms = 50;
+  args->GetNext(&threshold_ms);
+  JankDetector::GetInstance()->Start(
+      isolate(),
+      AtomBrowserMainParts::Get()->node_bindings(),
+      base::TimeDelta::FromMilliseconds(std::max(threshold_ms, 16)),
+      base::Bind(&App::OnLongTask, base::Unretained(this)));
+}
+
+void App::StopJankDetector() {
+  JankDetector::GetInstance()->Stop();
+}
+
+std::vector<JankDetector::LongTask> App::GetLongTasks() {
+  const std::deque<JankDetector::LongTask>& long_tasks =
+      JankDetector::GetInstance()->long_tasks();
+  return std::vector<JankDetector::LongTask>(long_tasks.begin(),
+                                             long_tasks.end());
+}
+
+void App::OnLongTask(const JankDetector::LongTask& long_task) {
+  Emit("long-task", long_task);
+}
+
+v8::Local<v8::Value> App::GetGCStatistics(v8::Isolate* isolate) {
+  auto idle_gc_scheduler = IdleGCScheduler::current();
+  if (!idle_gc_scheduler)
+    return v8::Null(isolate);
+
+  const IdleGCScheduler::Statistics& statistics =
+      idle_gc_scheduler->statistics();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("count", statistics.gc_count);
+  dict.Set("majorCount", statistics.major_gc_count);
+  dict.Set("idleCount", statistics.idle_gc_count);
+  dict.Set("totalPauseMs", statistics.total_pause.InMillisecondsF());
+  dict.Set("maxPauseMs", statistics.max_pause.InMillisecondsF());
+  dict.Set("idleNotificationCount", statistics.idle_notification_count);
+  dict.Set("idleTimeMs", statistics.idle_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+void App::PostMessage(int worker_id,
+                      v8::Local<v8::Value> message,
+                      mate::Arguments* args) {
+  v8::Local<v8::Value> transfer_list;
+  args->GetNext(&transfer_list);
+  brave::WorkerBindings::OnMessage(isolate(), worker_id, message,
+                                   transfer_list);
 }
 
 void App::StopWorker(mate::Arguments* args) {
@@ -843,9 +1027,11 @@ void App::StopWorker(mate::Arguments* args) {
     return;
   }
 
-  content::WorkerThreadRegistry::Instance()->
-      GetTaskRunnerFor(worker_id)->PostTask(
-          FROM_HERE, base::Bind(&brave::V8WorkerThread::Shutdown));
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      brave::V8WorkerThread::GetTaskRunnerFor(worker_id);
+  if (task_runner)
+    task_runner->PostTask(FROM_HERE,
+                          base::Bind(&brave::V8WorkerThread::Shutdown));
 }
 
 void App::StartWorker(mate::Arguments* args) {
@@ -859,12 +1045,51 @@ void App::StartWorker(mate::Arguments* args) {
   args->GetNext(&worker_name);
 
   auto worker = new brave::V8WorkerThread(worker_name, this);
-  worker->Start();
-  worker->WaitUntilThreadStarted();
-  worker->Require(module_name);
+  if (!worker->StartWithModule(module_name)) {
+    delete worker;
+    args->ThrowError("Failed to start the worker thread");
+    return;
+  }
   args->Return(worker->GetThreadId());
 }
 
+int App::StartWorkerPool(const std::string& module_name,
+                         mate::Arguments* args) {
+  int size = 0;
+  args->GetNext(&size);
+  if (size <= 0)
+    size = base::SysInfo::NumberOfProcessors();
+
+  int pool_id = next_worker_pool_id_++;
+  worker_pools_[pool_id].reset(
+      new brave::V8WorkerPool(pool_id, module_name, size, this));
+  return pool_id;
+}
+
+void App::StopWorkerPool(int pool_id) {
+  worker_pools_.erase(pool_id);
+}
+
+bool App::PostMessageToWorkerPool(int pool_id,
+                                  v8::Local<v8::Value> message,
+                                  mate::Arguments* args) {
+  auto it = worker_pools_.find(pool_id);
+  if (it == worker_pools_.end())
+    return false;
+
+  v8::Local<v8::Value> transfer_list;
+  args->GetNext(&transfer_list);
+  return it->second->PostMessage(isolate(), message, transfer_list);
+}
+
+std::vector<base::PlatformThreadId> App::GetWorkerPoolIds(int pool_id) {
+  auto it = worker_pools_.find(pool_id);
+  if (it == worker_pools_.end())
+    return std::vector<base::PlatformThreadId>();
+
+  return it->second->GetWorkerIds();
+}
+
 #if defined(USE_NSS_CERTS)
 void App::ImportCertificate(
     const base::DictionaryValue& options,
@@ -1020,9 +1245,23 @@ void App::BuildPrototype(
       .SetMethod("relaunch", &App::Relaunch)
       .SetMethod("isAccessibilitySupportEnabled",
                  &App::IsAccessibilitySupportEnabled)
+      .SetMethod("getGCStatistics", &App::GetGCStatistics)
+      .SetMethod("getStartupTimeline", &App::GetStartupTimeline)
+      .SetMethod("getProcessMetrics", &App::GetProcessMetrics)
+      .SetMethod("startProcessMetricsSampling",
+                 &App::StartProcessMetricsSampling)
+      .SetMethod("stopProcessMetricsSampling",
+                 &App::StopProcessMetricsSampling)
+      .SetMethod("startJankDetector", &App::StartJankDetector)
+      .SetMethod("stopJankDetector", &App::StopJankDetector)
+      .SetMethod("getLongTasks", &App::GetLongTasks)
       .SetMethod("_postMessage", &App::PostMessage)
       .SetMethod("_startWorker", &App::StartWorker)
       .SetMethod("stopWorker", &App::StopWorker)
+      .SetMethod("_startWorkerPool", &App::StartWorkerPool)
+      .SetMethod("_postMessageToWorkerPool", &App::PostMessageToWorkerPool)
+      .SetMethod("_getWorkerPoolIds", &App::GetWorkerPoolIds)
+      .SetMethod("stopWorkerPool", &App::StopWorkerPool)
       .SetMethod("disableHardwareAcceleration",
                  &App::DisableHardwareAcceleration);
 }
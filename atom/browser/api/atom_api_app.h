@@ -5,13 +5,20 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_APP_H_
 #define ATOM_BROWSER_API_ATOM_API_APP_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "atom/browser/api/event_emitter.h"
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/browser_observer.h"
+#include "atom/browser/jank_detector.h"
+#include "atom/browser/process_metrics_sampler.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "base/threading/platform_thread.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
 #include "content/public/browser/notification_observer.h"
@@ -28,6 +35,10 @@ namespace base {
 class FilePath;
 }
 
+namespace brave {
+class V8WorkerPool;
+}  // namespace brave
+
 namespace mate {
 class Arguments;
 }  // namespace mate
@@ -129,14 +140,41 @@ class App : public AtomBrowserClient::Delegate,
   void SetLocale(std::string);
   std::string GetLocale();
   bool MakeSingleInstance(
-      const ProcessSingleton::NotificationCallback& callback);
+      const ProcessSingleton::NotificationCallback& callback,
+      mate::Arguments* args);
   void ReleaseSingleInstance();
+  bool OnSecondInstance(const base::CommandLine::StringVector& argv,
+                        const base::FilePath& working_directory);
+  // Hands the pending launches to JS, then keeps collecting the ones that
+  // follow for kSecondInstanceBatchDelayMs.
+  void OnSecondInstanceTimer();
+  void FlushSecondInstances();
   bool Relaunch(mate::Arguments* args);
   void DisableHardwareAcceleration(mate::Arguments* args);
   bool IsAccessibilitySupportEnabled();
-  void PostMessage(int worker_id, v8::Local<v8::Value> message);
+  v8::Local<v8::Value> GetGCStatistics(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
+  void GetProcessMetrics(
+      const ProcessMetricsSampler::SampleCallback& callback);
+  void StartProcessMetricsSampling(int interval_ms);
+  void StopProcessMetricsSampling();
+  void OnProcessMetrics(
+      const ProcessMetricsSampler::ProcessInfoList& processes);
+  void StartJankDetector(mate::Arguments* args);
+  void StopJankDetector();
+  std::vector<JankDetector::LongTask> GetLongTasks();
+  void OnLongTask(const JankDetector::LongTask& long_task);
+  void PostMessage(int worker_id,
+                   v8::Local<v8::Value> message,
+                   mate::Arguments* args);
   void StartWorker(mate::Arguments* args);
   void StopWorker(mate::Arguments* args);
+  int StartWorkerPool(const std::string& module_name, mate::Arguments* args);
+  void StopWorkerPool(int pool_id);
+  bool PostMessageToWorkerPool(int pool_id,
+                               v8::Local<v8::Value> message,
+                               mate::Arguments* args);
+  std::vector<base::PlatformThreadId> GetWorkerPoolIds(int pool_id);
 #if defined(USE_NSS_CERTS)
   void ImportCertificate(const base::DictionaryValue& options,
                          const net::CompletionCallback& callback);
@@ -153,6 +191,16 @@ class App : public AtomBrowserClient::Delegate,
   content::NotificationRegistrar registrar_;
 
   std::unique_ptr<ProcessSingleton> process_singleton_;
+  ProcessSingleton::NotificationCallback single_instance_callback_;
+  // Launches of other instances that haven't been handed to JS yet.
+  std::vector<std::pair<base::CommandLine::StringVector, base::FilePath>>
+      pending_second_instances_;
+  base::OneShotTimer second_instance_timer_;
+
+  std::map<int, std::unique_ptr<brave::V8WorkerPool>> worker_pools_;
+  int next_worker_pool_id_;
+
+  std::unique_ptr<ProcessMetricsSampler> process_metrics_sampler_;
 
 #if defined(USE_NSS_CERTS)
   std::unique_ptr<CertificateManagerModel> certificate_manager_model_;
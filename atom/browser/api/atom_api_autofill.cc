@@ -4,110 +4,300 @@
 
 #include "atom/browser/api/atom_api_autofill.h"
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "atom/browser/autofill/personal_data_manager_factory.h"
+#include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
 #include "base/guid.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "components/autofill/core/browser/autofill_profile.h"
 #include "components/autofill/core/browser/credit_card.h"
 #include "components/autofill/core/browser/personal_data_manager.h"
+#include "components/autofill/core/browser/webdata/autofill_table.h"
+#include "components/autofill/core/browser/webdata/autofill_webdata_backend.h"
+#include "components/autofill/core/browser/webdata/autofill_webdata_service.h"
 #include "components/autofill/core/common/autofill_constants.h"
 #include "content/public/browser/browser_thread.h"
 #include "native_mate/dictionary.h"
 
-namespace mate {
+namespace {
 
-template<>
-struct Converter<autofill::AutofillProfile*> {
-  static v8::Local<v8::Value> ToV8(
-    v8::Isolate* isolate, autofill::AutofillProfile* val) {
-  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
-  std::string full_name, company_name, street_address, city, state, locality,
-    postal_code, sorting_code, country_code, phone, email;
-  if (val) {
-    full_name =
-      base::UTF16ToUTF8(val->GetInfo(
-        autofill::AutofillType(autofill::NAME_FULL),
-        brave::BraveContentBrowserClient::Get()
-        ->GetApplicationLocale()));
-    if (!full_name.empty()) {
-      dict.Set("full_name", full_name);
-    }
+using autofill::AutofillProfile;
+using autofill::AutofillTable;
+using autofill::CreditCard;
 
-    company_name =
-      base::UTF16ToUTF8(val->GetRawInfo(autofill::COMPANY_NAME));
-    if (!company_name.empty()) {
-      dict.Set("company_name", company_name);
-    }
+// Results of a paginated query run on the DB thread, handed back to the UI
+// thread once the query task has finished.
+struct QueryResult {
+  base::ListValue items;
+  int total = 0;
+};
 
-    street_address =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_STREET_ADDRESS));
-    if (!street_address.empty()) {
-      dict.Set("street_address", street_address);
-    }
+// Options accepted by getProfiles/getCreditCards.
+struct QueryOptions {
+  std::string query;
+  size_t offset = 0;
+  size_t limit = 0;
+};
 
-    city =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_CITY));
-    if (!city.empty()) {
-      dict.Set("city", city);
-    }
+std::string GetApplicationLocale() {
+  return brave::BraveContentBrowserClient::Get()->GetApplicationLocale();
+}
 
-    state =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_STATE));
-    if (!state.empty()) {
-      dict.Set("state", state);
-    }
+// Maps the keys of the JS representation to autofill fields.
+struct FieldMapping {
+  const char* key;
+  autofill::ServerFieldType type;
+};
 
-    locality =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_DEPENDENT_LOCALITY));
-    if (!locality.empty()) {
-      dict.Set("locality", locality);
-    }
+const FieldMapping kProfileFields[] = {
+  { "full_name", autofill::NAME_FULL },
+  { "company_name", autofill::COMPANY_NAME },
+  { "street_address", autofill::ADDRESS_HOME_STREET_ADDRESS },
+  { "city", autofill::ADDRESS_HOME_CITY },
+  { "state", autofill::ADDRESS_HOME_STATE },
+  { "locality", autofill::ADDRESS_HOME_DEPENDENT_LOCALITY },
+  { "postal_code", autofill::ADDRESS_HOME_ZIP },
+  { "sorting_code", autofill::ADDRESS_HOME_SORTING_CODE },
+  { "country_code", autofill::ADDRESS_HOME_COUNTRY },
+  { "phone", autofill::PHONE_HOME_WHOLE_NUMBER },
+  { "email", autofill::EMAIL_ADDRESS },
+};
 
-    postal_code =
-      base::UTF16ToUTF8(val->GetRawInfo(autofill::ADDRESS_HOME_ZIP));
-    if (!postal_code.empty()) {
-      dict.Set("postal_code", postal_code);
-    }
+const FieldMapping kCreditCardFields[] = {
+  { "name", autofill::CREDIT_CARD_NAME_FULL },
+  { "card_number", autofill::CREDIT_CARD_NUMBER },
+  { "expiration_month", autofill::CREDIT_CARD_EXP_MONTH },
+  { "expiration_year", autofill::CREDIT_CARD_EXP_4_DIGIT_YEAR },
+};
 
-    sorting_code =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_SORTING_CODE));
-    if (!sorting_code.empty()) {
-      dict.Set("sorting_code", sorting_code);
-    }
+// The full name is composed from its parts, every other field is reported
+// as stored.
+base::string16 GetField(const autofill::AutofillDataModel& model,
+                        autofill::ServerFieldType type,
+                        const std::string& app_locale) {
+  if (type == autofill::NAME_FULL)
+    return model.GetInfo(autofill::AutofillType(type), app_locale);
+  return model.GetRawInfo(type);
+}
 
-    country_code =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::ADDRESS_HOME_COUNTRY));
-    if (!country_code.empty()) {
-      dict.Set("country_code", country_code);
-    }
+template <size_t N>
+std::unique_ptr<base::DictionaryValue> ModelToValue(
+    const autofill::AutofillDataModel& model,
+    const FieldMapping (&fields)[N],
+    const std::string& app_locale) {
+  std::unique_ptr<base::DictionaryValue> dict(new base::DictionaryValue);
+  dict->SetString("guid", model.guid());
+  for (const FieldMapping& field : fields) {
+    base::string16 value = GetField(model, field.type, app_locale);
+    if (!value.empty())
+      dict->SetString(field.key, value);
+  }
+  return dict;
+}
 
-    phone =
-      base::UTF16ToUTF8(val->GetRawInfo(
-        autofill::PHONE_HOME_WHOLE_NUMBER));
-    if (!phone.empty()) {
-      dict.Set("phone", phone);
-    }
+std::unique_ptr<base::DictionaryValue> ProfileToValue(
+    const AutofillProfile& profile,
+    const std::string& app_locale) {
+  return ModelToValue(profile, kProfileFields, app_locale);
+}
 
-    email =
-      base::UTF16ToUTF8(val->GetRawInfo(autofill::EMAIL_ADDRESS));
-    if (!email.empty()) {
-      dict.Set("email", email);
-    }
-  }
-  return dict.GetHandle();
+std::unique_ptr<base::DictionaryValue> CreditCardToValue(
+    const CreditCard& card) {
+  return ModelToValue(card, kCreditCardFields, std::string());
+}
+
+void SetRawInfoIfNotEmpty(autofill::AutofillDataModel* model,
+                          const base::DictionaryValue& value,
+                          const std::string& key,
+                          autofill::ServerFieldType type) {
+  std::string info;
+  if (value.GetString(key, &info) && !info.empty())
+    model->SetRawInfo(type, base::UTF8ToUTF16(info));
+}
+
+// Fills |profile| from the JS representation used by addProfile.
+void ProfileFromValue(const base::DictionaryValue& value,
+                      const std::string& app_locale,
+                      AutofillProfile* profile) {
+  std::string full_name, language_code;
+  if (value.GetString("full_name", &full_name) && !full_name.empty()) {
+    profile->SetInfo(autofill::AutofillType(autofill::NAME_FULL),
+                     base::UTF8ToUTF16(full_name),
+                     app_locale);
+  }
+  SetRawInfoIfNotEmpty(profile, value, "company_name",
+                       autofill::COMPANY_NAME);
+  SetRawInfoIfNotEmpty(profile, value, "street_address",
+                       autofill::ADDRESS_HOME_STREET_ADDRESS);
+  SetRawInfoIfNotEmpty(profile, value, "city", autofill::ADDRESS_HOME_CITY);
+  SetRawInfoIfNotEmpty(profile, value, "state", autofill::ADDRESS_HOME_STATE);
+  SetRawInfoIfNotEmpty(profile, value, "locality",
+                       autofill::ADDRESS_HOME_DEPENDENT_LOCALITY);
+  SetRawInfoIfNotEmpty(profile, value, "postal_code",
+                       autofill::ADDRESS_HOME_ZIP);
+  SetRawInfoIfNotEmpty(profile, value, "sorting_code",
+                       autofill::ADDRESS_HOME_SORTING_CODE);
+  SetRawInfoIfNotEmpty(profile, value, "country_code",
+                       autofill::ADDRESS_HOME_COUNTRY);
+  SetRawInfoIfNotEmpty(profile, value, "phone",
+                       autofill::PHONE_HOME_WHOLE_NUMBER);
+  SetRawInfoIfNotEmpty(profile, value, "email", autofill::EMAIL_ADDRESS);
+  if (value.GetString("language_code", &language_code) &&
+      !language_code.empty())
+    profile->set_language_code(language_code);
+}
+
+// Fills |card| from the JS representation used by addCreditCard.
+void CreditCardFromValue(const base::DictionaryValue& value,
+                         CreditCard* card) {
+  SetRawInfoIfNotEmpty(card, value, "name", autofill::CREDIT_CARD_NAME_FULL);
+  SetRawInfoIfNotEmpty(card, value, "card_number",
+                       autofill::CREDIT_CARD_NUMBER);
+  SetRawInfoIfNotEmpty(card, value, "expiration_month",
+                       autofill::CREDIT_CARD_EXP_MONTH);
+  SetRawInfoIfNotEmpty(card, value, "expiration_year",
+                       autofill::CREDIT_CARD_EXP_4_DIGIT_YEAR);
+}
+
+// Case-insensitive match of |query| against every field of |model|.
+template <size_t N>
+bool MatchesQuery(const autofill::AutofillDataModel& model,
+                  const FieldMapping (&fields)[N],
+                  const std::string& app_locale,
+                  const std::string& query) {
+  if (query.empty())
+    return true;
+  for (const FieldMapping& field : fields) {
+    std::string value =
+        base::UTF16ToUTF8(GetField(model, field.type, app_locale));
+    if (base::ToLowerASCII(value).find(query) != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+// Counts the entries of |models| matching |options| and appends the page it
+// selects to |result|. Only the entries on the page are converted.
+template <typename T, size_t N>
+void Paginate(const std::vector<std::unique_ptr<T>>& models,
+              const FieldMapping (&fields)[N],
+              const QueryOptions& options,
+              const std::string& app_locale,
+              QueryResult* result) {
+  size_t matches = 0;
+  for (const auto& model : models) {
+    if (!MatchesQuery(*model, fields, app_locale, options.query))
+      continue;
+    if (matches >= options.offset &&
+        (!options.limit || matches < options.offset + options.limit))
+      result->items.Append(ModelToValue(*model, fields, app_locale));
+    ++matches;
+  }
+  result->total = static_cast<int>(matches);
+}
+
+// Returns the guid of the entry in |stored| that |model| would duplicate, or
+// an empty string. A new entry duplicates any entry with the same data, an
+// update only the unchanged entry it updates.
+template <typename T>
+std::string FindStoredCopy(const std::vector<const T*>& stored,
+                           const T& model) {
+  bool is_update = false;
+  for (const T* existing : stored)
+    is_update |= existing->guid() == model.guid();
+  for (const T* existing : stored) {
+    if ((!is_update || existing->guid() == model.guid()) &&
+        existing->Compare(model) == 0)
+      return existing->guid();
+  }
+  return std::string();
+}
+
+// The write tasks below run on the DB thread. Each one applies a whole batch
+// inside the single transaction the web database keeps open and asks for one
+// commit at the end. The batches were validated against the
+// PersonalDataManager's rules on the UI thread.
+WebDatabase::State WriteProfilesOnDB(
+    const std::vector<AutofillProfile>& profiles,
+    const std::vector<std::string>& removed_guids,
+    WebDatabase* db) {
+  AutofillTable* table = AutofillTable::FromWebDatabase(db);
+  for (const AutofillProfile& profile : profiles) {
+    if (!table->UpdateAutofillProfile(profile))
+      table->AddAutofillProfile(profile);
+  }
+  for (const std::string& guid : removed_guids)
+    table->RemoveAutofillProfile(guid);
+  return WebDatabase::COMMIT_NEEDED;
+}
+
+WebDatabase::State WriteCreditCardsOnDB(
+    const std::vector<CreditCard>& cards,
+    const std::vector<std::string>& removed_guids,
+    WebDatabase* db) {
+  AutofillTable* table = AutofillTable::FromWebDatabase(db);
+  for (const CreditCard& card : cards) {
+    if (!table->UpdateCreditCard(card))
+      table->AddCreditCard(card);
+  }
+  for (const std::string& guid : removed_guids)
+    table->RemoveCreditCard(guid);
+  return WebDatabase::COMMIT_NEEDED;
+}
+
+// Tells the web data observers, the PersonalDataManager among them, that a
+// batch was written, the same way sync reports its bulk changes.
+void NotifyOfBatchOnDB(autofill::AutofillWebDataBackend* backend) {
+  backend->NotifyOfMultipleAutofillChanges();
+}
+
+// AutofillTable can only load every entry, but only the requested page is
+// converted for the UI thread.
+WebDatabase::State QueryProfilesOnDB(const QueryOptions& options,
+                                     const std::string& app_locale,
+                                     QueryResult* result,
+                                     WebDatabase* db) {
+  std::vector<std::unique_ptr<AutofillProfile>> profiles;
+  AutofillTable::FromWebDatabase(db)->GetAutofillProfiles(&profiles);
+  Paginate(profiles, kProfileFields, options, app_locale, result);
+  return WebDatabase::COMMIT_NOT_NEEDED;
+}
+
+WebDatabase::State QueryCreditCardsOnDB(const QueryOptions& options,
+                                        QueryResult* result,
+                                        WebDatabase* db) {
+  std::vector<std::unique_ptr<CreditCard>> cards;
+  AutofillTable::FromWebDatabase(db)->GetCreditCards(&cards);
+  Paginate(cards, kCreditCardFields, options, std::string(), result);
+  return WebDatabase::COMMIT_NOT_NEEDED;
+}
+
+void RunQueryCallback(const atom::api::Autofill::QueryCallback& callback,
+                      QueryResult* result) {
+  callback.Run(result->items, result->total);
+}
+
+}  // namespace
+
+namespace mate {
+
+template<>
+struct Converter<autofill::AutofillProfile*> {
+  static v8::Local<v8::Value> ToV8(
+    v8::Isolate* isolate, autofill::AutofillProfile* val) {
+    if (!val)
+      return mate::Dictionary::CreateEmpty(isolate).GetHandle();
+    return mate::ConvertToV8(isolate,
+                             *ProfileToValue(*val, GetApplicationLocale()));
   }
 };
 
@@ -115,34 +305,28 @@ template<>
 struct Converter<autofill::CreditCard*> {
   static v8::Local<v8::Value> ToV8(
     v8::Isolate* isolate, autofill::CreditCard* val) {
-  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
-  std::string name, card_number, expiration_month, expiration_year;
-  if (val) {
-    name =
-    base::UTF16ToUTF8(val->GetRawInfo(autofill::CREDIT_CARD_NAME_FULL));
-    if (!name.empty()) {
-      dict.Set("name", name);
-    }
-
-    card_number =
-      base::UTF16ToUTF8(val->GetRawInfo(autofill::CREDIT_CARD_NUMBER));
-    if (!card_number.empty()) {
-      dict.Set("card_number", card_number);
-    }
-
-    expiration_month =
-      base::UTF16ToUTF8(val->GetRawInfo(autofill::CREDIT_CARD_EXP_MONTH));
-    if (!expiration_month.empty()) {
-      dict.Set("expiration_month", expiration_month);
-    }
-
-    expiration_year =
-    base::UTF16ToUTF8(val->GetRawInfo(autofill::CREDIT_CARD_EXP_4_DIGIT_YEAR));
-    if (!expiration_year.empty()) {
-      dict.Set("expiration_year", expiration_year);
-    }
+    if (!val)
+      return mate::Dictionary::CreateEmpty(isolate).GetHandle();
+    return mate::ConvertToV8(isolate, *CreditCardToValue(*val));
   }
-  return dict.GetHandle();
+};
+
+template<>
+struct Converter<QueryOptions> {
+  static bool FromV8(v8::Isolate* isolate, v8::Local<v8::Value> val,
+                     QueryOptions* out) {
+    mate::Dictionary options;
+    if (!ConvertFromV8(isolate, val, &options))
+      return false;
+    std::string query;
+    if (options.Get("query", &query))
+      out->query = base::ToLowerASCII(query);
+    int offset = 0, limit = 0;
+    if (options.Get("offset", &offset) && offset > 0)
+      out->offset = offset;
+    if (options.Get("limit", &limit) && limit > 0)
+      out->limit = limit;
+    return true;
   }
 };
 
@@ -171,20 +355,7 @@ Profile* Autofill::profile() {
 }
 
 void Autofill::AddProfile(const base::DictionaryValue& profile) {
-  std::string full_name, company_name, street_address, city, state, locality,
-    postal_code, sorting_code, country_code, phone, email, language_code, guid;
-  profile.GetString("full_name", &full_name);
-  profile.GetString("company_name", &company_name);
-  profile.GetString("street_address", &street_address);
-  profile.GetString("city", &city);
-  profile.GetString("state", &state);
-  profile.GetString("locality", &locality);
-  profile.GetString("postal_code", &postal_code);
-  profile.GetString("sorting_code", &sorting_code);
-  profile.GetString("country_code", &country_code);
-  profile.GetString("phone", &phone);
-  profile.GetString("email", &email);
-  profile.GetString("language_code", &language_code);
+  std::string guid;
   if (!profile.GetString("guid", &guid)) {
     NOTREACHED();
     return;
@@ -195,74 +366,7 @@ void Autofill::AddProfile(const base::DictionaryValue& profile) {
   }
 
   autofill::AutofillProfile autofill_profile(guid, autofill::kSettingsOrigin);
-
-  if (!full_name.empty()) {
-    autofill_profile.SetInfo(autofill::AutofillType(autofill::NAME_FULL),
-                    base::UTF8ToUTF16(full_name),
-                    brave::BraveContentBrowserClient::Get()
-                    ->GetApplicationLocale());
-  }
-
-  if (!company_name.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::COMPANY_NAME,
-        base::UTF8ToUTF16(company_name));
-  }
-
-  if (!street_address.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_STREET_ADDRESS,
-        base::UTF8ToUTF16(street_address));
-  }
-
-  if (!city.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_CITY,
-        base::UTF8ToUTF16(city));
-  }
-
-  if (!state.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_STATE,
-        base::UTF8ToUTF16(state));
-  }
-
-  if (!locality.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_DEPENDENT_LOCALITY,
-        base::UTF8ToUTF16(locality));
-  }
-
-  if (!postal_code.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_ZIP,
-        base::UTF8ToUTF16(postal_code));
-  }
-
-  if (!sorting_code.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_SORTING_CODE,
-        base::UTF8ToUTF16(sorting_code));
-  }
-
-  if (!country_code.empty()) {
-    autofill_profile.SetRawInfo(
-        autofill::ADDRESS_HOME_COUNTRY,
-        base::UTF8ToUTF16(country_code));
-  }
-
-  if (!phone.empty()) {
-    autofill_profile.SetRawInfo(autofill::PHONE_HOME_WHOLE_NUMBER,
-        base::UTF8ToUTF16(phone));
-  }
-
-  if (!email.empty()) {
-    autofill_profile.SetRawInfo(autofill::EMAIL_ADDRESS,
-                                base::UTF8ToUTF16(email));
-  }
-
-  if (!language_code.empty())
-    autofill_profile.set_language_code(language_code);
+  ProfileFromValue(profile, GetApplicationLocale(), &autofill_profile);
 
   if (!base::IsValidGUID(autofill_profile.guid())) {
     autofill_profile.set_guid(base::GenerateGUID());
@@ -291,11 +395,7 @@ void Autofill::RemoveProfile(const std::string& guid) {
 }
 
 void Autofill::AddCreditCard(const base::DictionaryValue& card) {
-  std::string name, card_number, expiration_month, expiration_year, guid;
-  card.GetString("name", &name);
-  card.GetString("card_number", &card_number);
-  card.GetString("expiration_month", &expiration_month);
-  card.GetString("expiration_year", &expiration_year);
+  std::string guid;
   if (!card.GetString("guid", &guid)) {
     NOTREACHED();
     return;
@@ -306,28 +406,7 @@ void Autofill::AddCreditCard(const base::DictionaryValue& card) {
   }
 
   autofill::CreditCard credit_card(guid, autofill::kSettingsOrigin);
-  if (!name.empty()) {
-    credit_card.SetRawInfo(autofill::CREDIT_CARD_NAME_FULL,
-                           base::UTF8ToUTF16(name));
-  }
-
-  if (!card_number.empty()) {
-    credit_card.SetRawInfo(
-        autofill::CREDIT_CARD_NUMBER,
-        base::UTF8ToUTF16(card_number));
-  }
-
-  if (!expiration_month.empty()) {
-    credit_card.SetRawInfo(
-        autofill::CREDIT_CARD_EXP_MONTH,
-        base::UTF8ToUTF16(expiration_month));
-  }
-
-  if (!expiration_year.empty()) {
-    credit_card.SetRawInfo(
-        autofill::CREDIT_CARD_EXP_4_DIGIT_YEAR,
-        base::UTF8ToUTF16(expiration_year));
-  }
+  CreditCardFromValue(card, &credit_card);
 
   if (!base::IsValidGUID(credit_card.guid())) {
     credit_card.set_guid(base::GenerateGUID());
@@ -353,6 +432,216 @@ void Autofill::RemoveCreditCard(const std::string& guid) {
   personal_data_manager_->RemoveByGUID(guid);
 }
 
+void Autofill::AddProfiles(const base::ListValue& profiles,
+                           mate::Arguments* args) {
+  BatchCallback callback;
+  args->GetNext(&callback);
+
+  const std::string app_locale = GetApplicationLocale();
+  std::vector<const AutofillProfile*> stored;
+  if (personal_data_manager_) {
+    for (const AutofillProfile* profile : personal_data_manager_->GetProfiles())
+      stored.push_back(profile);
+  }
+
+  std::vector<AutofillProfile> autofill_profiles;
+  // |stored| points into it.
+  autofill_profiles.reserve(profiles.GetSize());
+  std::vector<std::string> guids;
+  for (const auto& value : profiles) {
+    const base::DictionaryValue* profile;
+    if (!value->GetAsDictionary(&profile)) {
+      guids.push_back(std::string());
+      continue;
+    }
+    std::string guid;
+    profile->GetString("guid", &guid);
+    AutofillProfile autofill_profile(guid, autofill::kSettingsOrigin);
+    ProfileFromValue(*profile, app_locale, &autofill_profile);
+    if (!base::IsValidGUID(autofill_profile.guid()))
+      autofill_profile.set_guid(base::GenerateGUID());
+
+    // Same rules as PersonalDataManager::AddProfile and UpdateProfile.
+    if (autofill_profile.IsEmpty(app_locale)) {
+      guids.push_back(std::string());
+      continue;
+    }
+    std::string stored_guid = FindStoredCopy(stored, autofill_profile);
+    if (!stored_guid.empty()) {
+      guids.push_back(stored_guid);
+      continue;
+    }
+    guids.push_back(autofill_profile.guid());
+    autofill_profiles.push_back(autofill_profile);
+    stored.push_back(&autofill_profiles.back());
+  }
+
+  ScheduleBatchWrite(base::Bind(&WriteProfilesOnDB, autofill_profiles,
+                                std::vector<std::string>()),
+                     guids, callback);
+}
+
+void Autofill::RemoveProfiles(const std::vector<std::string>& guids,
+                              mate::Arguments* args) {
+  BatchCallback callback;
+  args->GetNext(&callback);
+
+  ScheduleBatchWrite(base::Bind(&WriteProfilesOnDB,
+                                std::vector<AutofillProfile>(), guids),
+                     guids, callback);
+}
+
+void Autofill::GetProfiles(mate::Arguments* args) {
+  QueryOptions options;
+  QueryCallback callback;
+  args->GetNext(&options);
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+
+  QueryResult* result = new QueryResult;
+  ScheduleQuery(base::Bind(&QueryProfilesOnDB, options, GetApplicationLocale(),
+                           base::Unretained(result)),
+                base::Bind(&RunQueryCallback, callback, base::Owned(result)));
+}
+
+void Autofill::AddCreditCards(const base::ListValue& cards,
+                              mate::Arguments* args) {
+  BatchCallback callback;
+  args->GetNext(&callback);
+
+  const std::string app_locale = GetApplicationLocale();
+  std::vector<const CreditCard*> stored;
+  if (personal_data_manager_) {
+    for (const CreditCard* card : personal_data_manager_->GetCreditCards())
+      stored.push_back(card);
+  }
+
+  std::vector<CreditCard> credit_cards;
+  // |stored| points into it.
+  credit_cards.reserve(cards.GetSize());
+  std::vector<std::string> guids;
+  for (const auto& value : cards) {
+    const base::DictionaryValue* card;
+    if (!value->GetAsDictionary(&card)) {
+      guids.push_back(std::string());
+      continue;
+    }
+    std::string guid;
+    card->GetString("guid", &guid);
+    CreditCard credit_card(guid, autofill::kSettingsOrigin);
+    CreditCardFromValue(*card, &credit_card);
+    if (!base::IsValidGUID(credit_card.guid()))
+      credit_card.set_guid(base::GenerateGUID());
+
+    // Same rules as PersonalDataManager::AddCreditCard and UpdateCreditCard.
+    if (credit_card.IsEmpty(app_locale)) {
+      guids.push_back(std::string());
+      continue;
+    }
+    std::string stored_guid = FindStoredCopy(stored, credit_card);
+    if (!stored_guid.empty()) {
+      guids.push_back(stored_guid);
+      continue;
+    }
+    guids.push_back(credit_card.guid());
+    credit_cards.push_back(credit_card);
+    stored.push_back(&credit_cards.back());
+  }
+
+  ScheduleBatchWrite(base::Bind(&WriteCreditCardsOnDB, credit_cards,
+                                std::vector<std::string>()),
+                     guids, callback);
+}
+
+void Autofill::RemoveCreditCards(const std::vector<std::string>& guids,
+                                 mate::Arguments* args) {
+  BatchCallback callback;
+  args->GetNext(&callback);
+
+  ScheduleBatchWrite(base::Bind(&WriteCreditCardsOnDB,
+                                std::vector<CreditCard>(), guids),
+                     guids, callback);
+}
+
+void Autofill::GetCreditCards(mate::Arguments* args) {
+  QueryOptions options;
+  QueryCallback callback;
+  args->GetNext(&options);
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+
+  QueryResult* result = new QueryResult;
+  ScheduleQuery(base::Bind(&QueryCreditCardsOnDB, options,
+                           base::Unretained(result)),
+                base::Bind(&RunQueryCallback, callback, base::Owned(result)));
+}
+
+void Autofill::ScheduleBatchWrite(const WebDatabaseService::WriteTask& task,
+                                  const std::vector<std::string>& guids,
+                                  const BatchCallback& callback) {
+  scoped_refptr<WebDatabaseService> web_database =
+      brave::BraveBrowserContext::FromBrowserContext(browser_context_)
+          ->GetWebDatabaseService();
+  if (!web_database.get()) {
+    OnBatchWritten(std::vector<std::string>(), callback, false);
+    return;
+  }
+
+  web_database->ScheduleDBTask(FROM_HERE, task);
+  // Observers learn about the batch once it has been written, the
+  // PersonalDataManager reloads and fires a single personal-data-changed
+  // event for the whole batch.
+  scoped_refptr<autofill::AutofillWebDataService> web_data_service =
+      profile()->GetAutofillWebdataService();
+  if (web_data_service.get())
+    web_data_service->GetAutofillBackend(base::Bind(&NotifyOfBatchOnDB));
+  content::BrowserThread::PostTaskAndReply(content::BrowserThread::DB,
+    FROM_HERE,
+    base::Bind(&base::DoNothing),
+    base::Bind(&Autofill::OnBatchWritten,
+               weak_ptr_factory_.GetWeakPtr(), guids, callback, true));
+}
+
+void Autofill::ScheduleQuery(const WebDatabaseService::WriteTask& task,
+                             const base::Closure& reply) {
+  scoped_refptr<WebDatabaseService> web_database =
+      brave::BraveBrowserContext::FromBrowserContext(browser_context_)
+          ->GetWebDatabaseService();
+  if (!web_database.get()) {
+    reply.Run();
+    return;
+  }
+
+  web_database->ScheduleDBTask(FROM_HERE, task);
+  content::BrowserThread::PostTaskAndReply(content::BrowserThread::DB,
+    FROM_HERE,
+    base::Bind(&base::DoNothing),
+    reply);
+}
+
+void Autofill::OnBatchWritten(const std::vector<std::string>& guids,
+                              const BatchCallback& callback,
+                              bool success) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  // The callback is optional.
+  if (callback.is_null())
+    return;
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  if (success) {
+    callback.Run(v8::Null(isolate()), guids);
+  } else {
+    callback.Run(v8::Exception::Error(mate::StringToV8(
+        isolate(), "The web database is not available")), guids);
+  }
+}
+
 void Autofill::ClearAutocompleteData() {
   scoped_refptr<autofill::AutofillWebDataService> web_data_service =
     profile()->GetAutofillWebdataService();
@@ -458,6 +747,12 @@ void Autofill::BuildPrototype(v8::Isolate* isolate,
     .SetMethod("addCreditCard", &Autofill::AddCreditCard)
     .SetMethod("getCreditCard", &Autofill::GetCreditCard)
     .SetMethod("removeCreditCard", &Autofill::RemoveCreditCard)
+    .SetMethod("addProfiles", &Autofill::AddProfiles)
+    .SetMethod("removeProfiles", &Autofill::RemoveProfiles)
+    .SetMethod("getProfiles", &Autofill::GetProfiles)
+    .SetMethod("addCreditCards", &Autofill::AddCreditCards)
+    .SetMethod("removeCreditCards", &Autofill::RemoveCreditCards)
+    .SetMethod("getCreditCards", &Autofill::GetCreditCards)
     .SetMethod("clearAutocompleteData", &Autofill::ClearAutocompleteData)
     .SetMethod("clearAutofillData", &Autofill::ClearAutofillData);
 }
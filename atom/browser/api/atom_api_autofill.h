@@ -6,11 +6,13 @@
 #define ATOM_BROWSER_API_ATOM_API_AUTOFILL_H_
 
 #include <string>
+#include <vector>
 
 #include "atom/browser/api/trackable_object.h"
 #include "base/callback.h"
 #include "brave/browser/brave_browser_context.h"
 #include "components/autofill/core/browser/personal_data_manager_observer.h"
+#include "components/webdata/common/web_database_service.h"
 #include "native_mate/handle.h"
 
 namespace autofill {
@@ -34,6 +36,11 @@ namespace api {
 class Autofill : public mate::TrackableObject<Autofill>,
                  public autofill::PersonalDataManagerObserver {
  public:
+  using BatchCallback = base::Callback<void(v8::Local<v8::Value>,
+                                            const std::vector<std::string>&)>;
+  using QueryCallback =
+      base::Callback<void(const base::ListValue&, int)>;
+
   static mate::Handle<Autofill> Create(v8::Isolate* isolate,
                                   content::BrowserContext* browser_context);
 
@@ -53,6 +60,22 @@ class Autofill : public mate::TrackableObject<Autofill>,
   autofill::CreditCard* GetCreditCard(const std::string& guid);
   void RemoveCreditCard(const std::string& guid);
 
+  // Batched variants of the calls above. Each batch is written in a single
+  // web database transaction and produces one personal-data-changed event.
+  // Entries are filtered like the PersonalDataManager does: empty ones are
+  // skipped and duplicates of stored ones aren't written again.
+  void AddProfiles(const base::ListValue& profiles, mate::Arguments* args);
+  void RemoveProfiles(const std::vector<std::string>& guids,
+                      mate::Arguments* args);
+  void AddCreditCards(const base::ListValue& cards, mate::Arguments* args);
+  void RemoveCreditCards(const std::vector<std::string>& guids,
+                         mate::Arguments* args);
+
+  // Paginated enumeration and search, run against the web database on the
+  // DB thread.
+  void GetProfiles(mate::Arguments* args);
+  void GetCreditCards(mate::Arguments* args);
+
   void ClearAutocompleteData();
   void ClearAutofillData();
 
@@ -61,6 +84,15 @@ class Autofill : public mate::TrackableObject<Autofill>,
 
   Profile* profile();
  private:
+  void ScheduleBatchWrite(const WebDatabaseService::WriteTask& task,
+                          const std::vector<std::string>& guids,
+                          const BatchCallback& callback);
+  void ScheduleQuery(const WebDatabaseService::WriteTask& task,
+                     const base::Closure& reply);
+  void OnBatchWritten(const std::vector<std::string>& guids,
+                      const BatchCallback& callback,
+                      bool success);
+
   void OnClearedAutocompleteData();
   void OnClearedAutofillData();
 
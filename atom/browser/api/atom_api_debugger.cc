@@ -6,12 +6,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/value_converter.h"
-#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "native_mate/dictionary.h"
@@ -25,8 +26,28 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+// Events are serialized with "method" as their first key, which lets us read
+// the method without parsing the message. Returns false for anything else,
+// including command responses.
+bool GetEventMethod(const std::string& message, std::string* method) {
+  const char kMethodPrefix[] = "{\"method\":\"";
+  if (!base::StartsWith(message, kMethodPrefix, base::CompareCase::SENSITIVE))
+    return false;
+  size_t start = arraysize(kMethodPrefix) - 1;
+  size_t end = message.find('"', start);
+  if (end == std::string::npos)
+    return false;
+  *method = message.substr(start, end - start);
+  return true;
+}
+
+}  // namespace
+
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
     : web_contents_(web_contents),
+      raw_messages_(false),
       previous_request_id_(0) {
   Init(isolate);
 }
@@ -46,40 +67,69 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
                                        const std::string& message) {
   DCHECK(agent_host == agent_host_.get());
 
-  std::unique_ptr<base::Value> parsed_message(base::JSONReader::Read(message));
-  if (!parsed_message->IsType(base::Value::TYPE_DICTIONARY))
+  // Filtered and raw events never get parsed.
+  std::string method;
+  bool is_event = GetEventMethod(message, &method);
+  if (is_event && !ShouldDispatchEvent(method))
+    return;
+  if (is_event && raw_messages_) {
+    Emit("message", method, message);
+    return;
+  }
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Context> context = GetWrapper()->CreationContext();
+  v8::Context::Scope context_scope(context);
+
+  v8::Local<v8::Value> parsed_message;
+  if (!v8::JSON::Parse(context, mate::StringToV8(isolate(), message))
+          .ToLocal(&parsed_message) ||
+      !parsed_message->IsObject())
     return;
 
-  base::DictionaryValue* dict =
-      static_cast<base::DictionaryValue*>(parsed_message.get());
+  mate::Dictionary dict(isolate(), parsed_message.As<v8::Object>());
   int id;
-  if (!dict->GetInteger("id", &id)) {
-    std::string method;
-    if (!dict->GetString("method", &method))
-      return;
-    base::DictionaryValue* params_value = nullptr;
-    base::DictionaryValue params;
-    if (dict->GetDictionary("params", &params_value))
-      params.Swap(params_value);
+  if (!dict.Get("id", &id)) {
+    if (!is_event) {
+      if (!dict.Get("method", &method) || !ShouldDispatchEvent(method))
+        return;
+      if (raw_messages_) {
+        Emit("message", method, message);
+        return;
+      }
+    }
+    v8::Local<v8::Value> params;
+    if (!dict.Get("params", &params) || !params->IsObject())
+      params = v8::Object::New(isolate());
     Emit("message", method, params);
   } else {
-    auto send_command_callback = pending_requests_[id];
-    pending_requests_.erase(id);
+    auto it = pending_requests_.find(id);
+    if (it == pending_requests_.end())
+      return;
+    SendCommandCallback send_command_callback = it->second;
+    pending_requests_.erase(it);
     if (send_command_callback.is_null())
       return;
-    base::DictionaryValue* error_body = nullptr;
-    base::DictionaryValue error;
-    if (dict->GetDictionary("error", &error_body))
-      error.Swap(error_body);
-
-    base::DictionaryValue* result_body = nullptr;
-    base::DictionaryValue result;
-    if (dict->GetDictionary("result", &result_body))
-      result.Swap(result_body);
+    v8::Local<v8::Value> error;
+    if (!dict.Get("error", &error) || !error->IsObject())
+      error = v8::Object::New(isolate());
+
+    v8::Local<v8::Value> result;
+    if (!dict.Get("result", &result) || !result->IsObject())
+      result = v8::Object::New(isolate());
     send_command_callback.Run(error, result);
   }
 }
 
+bool Debugger::ShouldDispatchEvent(const std::string& method) const {
+  if (event_filter_.empty() || event_filter_.count(method))
+    return true;
+  size_t dot = method.find('.');
+  return dot != std::string::npos &&
+      event_filter_.count(method.substr(0, dot));
+}
+
 void Debugger::Attach(mate::Arguments* args) {
   std::string protocol_version;
   args->GetNext(&protocol_version);
@@ -114,6 +164,19 @@ void Debugger::Detach() {
   agent_host_ = nullptr;
 }
 
+void Debugger::SetEventFilter(mate::Arguments* args) {
+  std::vector<std::string> filter;
+  if (args->Length() > 0 && !args->GetNext(&filter)) {
+    args->ThrowError("`filter` must be an array of strings");
+    return;
+  }
+  event_filter_ = std::set<std::string>(filter.begin(), filter.end());
+}
+
+void Debugger::SetRawMessages(bool raw_messages) {
+  raw_messages_ = raw_messages;
+}
+
 void Debugger::SendCommand(mate::Arguments* args) {
   if (!agent_host_.get())
     return;
@@ -156,6 +219,8 @@ void Debugger::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
+      .SetMethod("setEventFilter", &Debugger::SetEventFilter)
+      .SetMethod("setRawMessages", &Debugger::SetRawMessages)
       .SetMethod("sendCommand", &Debugger::SendCommand);
 }
 
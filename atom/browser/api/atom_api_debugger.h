@@ -6,6 +6,7 @@
 #define ATOM_BROWSER_API_ATOM_API_DEBUGGER_H_
 
 #include <map>
+#include <set>
 #include <string>
 
 #include "atom/browser/api/trackable_object.h"
@@ -31,8 +32,7 @@ class Debugger: public mate::TrackableObject<Debugger>,
                 public content::DevToolsAgentHostClient {
  public:
   using SendCommandCallback =
-      base::Callback<void(const base::DictionaryValue&,
-                          const base::DictionaryValue&)>;
+      base::Callback<void(v8::Local<v8::Value>, v8::Local<v8::Value>)>;
 
   static mate::Handle<Debugger> Create(
       v8::Isolate* isolate, content::WebContents* web_contents);
@@ -57,11 +57,20 @@ class Debugger: public mate::TrackableObject<Debugger>,
   void Attach(mate::Arguments* args);
   bool IsAttached();
   void Detach();
+  void SetEventFilter(mate::Arguments* args);
+  void SetRawMessages(bool raw_messages);
   void SendCommand(mate::Arguments* args);
 
+  // Whether |method| passes |event_filter_|, which holds method and domain
+  // names. An empty filter lets every event through.
+  bool ShouldDispatchEvent(const std::string& method) const;
+
   content::WebContents* web_contents_;  // Weak Reference.
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
 
+  std::set<std::string> event_filter_;
+  bool raw_messages_;
+
   PendingRequestMap pending_requests_;
   int previous_request_id_;
 
@@ -36,6 +36,31 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+std::string ImportItemToString(importer::ImportItem item) {
+  switch (item) {
+    case importer::HISTORY:
+      return "history";
+    case importer::FAVORITES:
+      return "favorites";
+    case importer::COOKIES:
+      return "cookies";
+    case importer::PASSWORDS:
+      return "passwords";
+    case importer::SEARCH_ENGINES:
+      return "search";
+    case importer::HOME_PAGE:
+      return "homepage";
+    case importer::AUTOFILL_FORM_DATA:
+      return "autofill-form-data";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
 Importer::Importer(v8::Isolate* isolate)
   : importer_host_(NULL),
   import_did_succeed_(false) {
@@ -127,6 +152,7 @@ void Importer::StartImport(
     importer_host_->set_observer(NULL);
 
   import_did_succeed_ = false;
+  imported_counts_.clear();
 
   importer_host_ = new ExternalProcessImporterHost();
   importer_host_->set_observer(this);
@@ -175,6 +201,14 @@ mate::Handle<Importer> Importer::Create(v8::Isolate* isolate) {
   return mate::CreateHandle(isolate, new Importer(isolate));
 }
 
+void Importer::OnItemsImported(importer::ImportItem item, size_t count) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+
+  size_t& total = imported_counts_[item];
+  total += count;
+  Emit("import-progress", ImportItemToString(item), static_cast<int>(total));
+}
+
 void Importer::ImportStarted() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 }
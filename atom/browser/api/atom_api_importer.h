@@ -35,6 +35,10 @@ class Importer: public mate::EventEmitter<Importer>,
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
+  // Called by the ProfileWriter after a batch of |count| entries of |item|
+  // has been emitted, so JS can track progress of a streamed import.
+  void OnItemsImported(importer::ImportItem item, size_t count);
+
  protected:
   explicit Importer(v8::Isolate* isolate);
   ~Importer() override;
@@ -64,6 +68,9 @@ class Importer: public mate::EventEmitter<Importer>,
 
   bool import_did_succeed_;
 
+  // Number of entries emitted so far for each item of the current import.
+  std::map<importer::ImportItem, size_t> imported_counts_;
+
   DISALLOW_COPY_AND_ASSIGN(Importer);
 };
 
@@ -65,11 +65,6 @@
 using content::BrowserThread;
 using content::StoragePartition;
 
-class ScopedAllowWaitForLegacyWebViewApi {
- private:
-  base::ThreadRestrictions::ScopedAllowWait wait;
-};
-
 namespace {
 
 struct ClearStorageDataOptions {
@@ -606,12 +601,8 @@ mate::Handle<Session> Session::FromPartition(
     const base::DictionaryValue& options) {
   scoped_refptr<AtomBrowserContext> browser_context =
       brave::BraveBrowserContext::FromPartition(partition, options);
-
-  DCHECK(browser_context.get());
-  // TODO(bridiver) - this is a huge hack to deal with sync call
-  ScopedAllowWaitForLegacyWebViewApi wait_allowed;
-  static_cast<brave::BraveBrowserContext*>(
-      browser_context.get())->ready()->Wait();
+  if (!browser_context)
+    return mate::Handle<Session>();
 
   return CreateFrom(isolate, browser_context.get());
 }
@@ -665,7 +656,39 @@ v8::Local<v8::Value> FromPartition(
   }
   base::DictionaryValue options;
   args->GetNext(&options);
-  return Session::FromPartition(args->isolate(), partition, options).ToV8();
+  mate::Handle<Session> session =
+      Session::FromPartition(args->isolate(), partition, options);
+  if (session.IsEmpty()) {
+    args->ThrowError(
+        "Session is still loading, use session.fromPartitionAsync");
+    return v8::Null(args->isolate());
+  }
+  return session.ToV8();
+}
+
+void OnPartitionReady(
+    v8::Isolate* isolate,
+    const base::Callback<void(v8::Local<v8::Value>)>& callback,
+    scoped_refptr<atom::AtomBrowserContext> browser_context) {
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  callback.Run(Session::CreateFrom(isolate, browser_context.get()).ToV8());
+}
+
+void FromPartitionAsync(const std::string& partition, mate::Arguments* args) {
+  if (!atom::Browser::Get()->is_ready()) {
+    args->ThrowError("Session can only be received when app is ready");
+    return;
+  }
+  base::DictionaryValue options;
+  args->GetNext(&options);
+  base::Callback<void(v8::Local<v8::Value>)> callback;
+  if (!args->GetNext(&callback)) {
+    args->ThrowError("Must pass a callback");
+    return;
+  }
+  brave::BraveBrowserContext::FromPartitionAsync(partition, options,
+      base::Bind(&OnPartitionReady, args->isolate(), callback));
 }
 
 void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
@@ -674,6 +697,7 @@ void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
   mate::Dictionary dict(isolate, exports);
   dict.Set("Session", Session::GetConstructor(isolate)->GetFunction());
   dict.SetMethod("fromPartition", &FromPartition);
+  dict.SetMethod("fromPartitionAsync", &FromPartitionAsync);
 }
 
 }  // namespace
@@ -48,7 +48,8 @@ class Session: public mate::TrackableObject<Session>,
   static mate::Handle<Session> CreateFrom(
       v8::Isolate* isolate, AtomBrowserContext* browser_context);
 
-  // Gets the Session of |partition|.
+  // Gets the Session of |partition|. Returns an empty handle while it is
+  // still being loaded by session.fromPartitionAsync.
   static mate::Handle<Session> FromPartition(
       v8::Isolate* isolate, const std::string& partition,
       const base::DictionaryValue& options = base::DictionaryValue());
@@ -2,10 +2,12 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/api/atom_api_web_contents.h"
 
@@ -19,6 +21,7 @@
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/autofill/atom_autofill_client.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/idle_gc_scheduler.h"
 #include "atom/browser/lib/bluetooth_chooser.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/net/atom_network_delegate.h"
@@ -101,6 +104,7 @@
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "atom/browser/extensions/tab_helper.h"
+#include "atom/browser/extensions/tab_lifecycle_manager.h"
 #include "brave/browser/api/brave_api_extension.h"
 #include "extensions/browser/api/extensions_api_client.h"
 #endif
@@ -304,6 +308,48 @@ void OnCapturePageDone(base::Callback<void(const gfx::Image&)> callback,
   callback.Run(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+// Fields that can be read by GetAllWebContentsInfo.
+enum InfoField {
+  INFO_ID = 1 << 0,
+  INFO_TYPE = 1 << 1,
+  INFO_URL = 1 << 2,
+  INFO_TITLE = 1 << 3,
+  INFO_IS_LOADING = 1 << 4,
+  INFO_IS_CRASHED = 1 << 5,
+  INFO_IS_FOCUSED = 1 << 6,
+  INFO_IS_AUDIO_MUTED = 1 << 7,
+  INFO_IS_DISCARDED = 1 << 8,
+  INFO_GUEST_INSTANCE_ID = 1 << 9,
+  INFO_OWNER_WINDOW_ID = 1 << 10,
+};
+
+const struct {
+  const char* name;
+  InfoField field;
+} kInfoFields[] = {
+  { "id", INFO_ID },
+  { "type", INFO_TYPE },
+  { "url", INFO_URL },
+  { "title", INFO_TITLE },
+  { "isLoading", INFO_IS_LOADING },
+  { "isCrashed", INFO_IS_CRASHED },
+  { "isFocused", INFO_IS_FOCUSED },
+  { "isAudioMuted", INFO_IS_AUDIO_MUTED },
+  { "isDiscarded", INFO_IS_DISCARDED },
+  { "guestInstanceId", INFO_GUEST_INSTANCE_ID },
+  { "ownerWindowId", INFO_OWNER_WINDOW_ID },
+};
+
+const int kDefaultInfoFields =
+    INFO_ID | INFO_TYPE | INFO_URL | INFO_TITLE | INFO_IS_LOADING;
+
+// Returns 0 if the window has no JS wrapper.
+int32_t GetOwnerWindowId(NativeWindow* owner_window) {
+  if (!owner_window)
+    return 0;
+  return mate::TrackableObjectBase::GetIDFromWrappedClass(owner_window);
+}
+
 }  // namespace
 
 WebContents::WebContents(v8::Isolate* isolate,
@@ -336,27 +382,6 @@ WebContents::WebContents(v8::Isolate* isolate, const mate::Dictionary& options,
   CreateWebContents(isolate, options, create_params);
 }
 
-WebContents::WebContents(v8::Isolate* isolate, const mate::Dictionary& options)
-    : type_(BROWSER_WINDOW),
-      request_id_(0),
-      enable_devtools_(true),
-      is_being_destroyed_(false),
-      guest_delegate_(nullptr) {
-  mate::Handle<api::Session> session;
-
-  // Obtain the session.
-  std::string partition;
-  if (options.Get("partition", &session)) {
-  } else if (options.Get("partition", &partition)) {
-    session = Session::FromPartition(isolate, partition);
-  } else {
-    // Use the default session if not specified.
-    session = Session::FromPartition(isolate, "");
-  }
-  content::WebContents::CreateParams create_params(session->browser_context());
-  CreateWebContents(isolate, options, create_params);
-}
-
 WebContents::~WebContents() {
   // The WebContentsDestroyed will not be called automatically because we
   // unsubscribe from webContents before destroying it. So we have to manually
@@ -685,6 +710,19 @@ void WebContents::UpdateTargetURL(content::WebContents* source,
   Emit("update-target-url", url, x, y);
 }
 
+void WebContents::NavigationStateChanged(
+    content::WebContents* source,
+    content::InvalidateTypes changed_flags) {
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  // The audio stream monitor invalidates the tab when audibility changes.
+  if (changed_flags & content::INVALIDATE_TYPE_TAB) {
+    auto tab_helper = extensions::TabHelper::FromWebContents(source);
+    if (tab_helper)
+      tab_helper->OnAudioStateChanged(source->WasRecentlyAudible());
+  }
+#endif
+}
+
 void WebContents::LoadProgressChanged(content::WebContents* source,
                                    double progress) {
   Emit("load-progress-changed", progress);
@@ -861,7 +899,21 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
   Emit("render-view-deleted", render_view_host->GetProcess()->GetID());
 }
 
+void WebContents::RenderViewHostChanged(content::RenderViewHost* old_host,
+                                        content::RenderViewHost* new_host) {
+  // The batch would otherwise go to the new view, which was never sent any
+  // of its messages.
+  DiscardIPCBatch();
+}
+
 void WebContents::RenderProcessGone(base::TerminationStatus status) {
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  if (tab_helper && tab_helper->IsDiscarded()) {
+    Emit("discarded");
+    return;
+  }
+#endif
   Emit("crashed");
 }
 
@@ -932,6 +984,14 @@ void WebContents::DidStopLoading() {
   Emit("did-stop-loading");
 }
 
+void WebContents::DidGetUserInteraction(
+    const blink::WebInputEvent::Type type) {
+  // Keeps idle-time GC from running while the user is interacting.
+  auto idle_gc_scheduler = IdleGCScheduler::current();
+  if (idle_gc_scheduler)
+    idle_gc_scheduler->NotifyUserActivity();
+}
+
 void WebContents::DidGetResourceResponseStart(
     const content::ResourceRequestDetails& details) {
   Emit("did-get-response-details",
@@ -974,6 +1034,9 @@ void WebContents::DidFinishNavigation(
     content::NavigationHandle* navigation_handle) {
   bool is_main_frame = navigation_handle->IsInMainFrame();
   auto url = navigation_handle->GetURL();
+  if (is_main_frame && navigation_handle->HasCommitted() &&
+      !navigation_handle->IsSamePage())
+    DiscardIPCBatch();
   if (navigation_handle->HasCommitted() && !navigation_handle->IsErrorPage()) {
     bool is_in_page = navigation_handle->IsSamePage();
     bool is_renderer_initiated = navigation_handle->IsRendererInitiated();
@@ -1070,6 +1133,7 @@ bool WebContents::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(WebContents, message)
     IPC_MESSAGE_HANDLER(AtomViewHostMsg_Message, OnRendererMessage)
+    IPC_MESSAGE_HANDLER(AtomViewHostMsg_MessageBatch, OnRendererMessageBatch)
     IPC_MESSAGE_HANDLER_DELAY_REPLY(AtomViewHostMsg_Message_Sync,
                                     OnRendererMessageSync)
     IPC_MESSAGE_HANDLER_CODE(ViewHostMsg_SetCursor, OnCursorChange,
@@ -1742,14 +1806,89 @@ void WebContents::SetTabValues(const base::DictionaryValue& values) {
 
   return tab_helper->SetTabValues(values);
 }
+
+bool WebContents::Discard() {
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  return tab_helper && tab_helper->Discard();
+}
+
+bool WebContents::IsDiscarded() {
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  return tab_helper && tab_helper->IsDiscarded();
+}
+
+void WebContents::SetAutoDiscardable(bool auto_discardable) {
+  auto tab_helper = extensions::TabHelper::FromWebContents(web_contents());
+  if (tab_helper)
+    tab_helper->SetAutoDiscardable(auto_discardable);
+}
+
+// static
+void WebContents::SetMaxLiveTabs(int max_live_tabs) {
+  extensions::TabLifecycleManager::GetInstance()->SetMaxLiveTabs(
+      std::max(max_live_tabs, 0));
+}
+
+// static
+std::vector<int32_t> WebContents::GetTabIDsForWindow(int32_t window_id) {
+  return extensions::TabHelper::GetTabIdsForWindow(window_id);
+}
+
+// static
+int32_t WebContents::GetActiveTabIDForWindow(int32_t window_id) {
+  return extensions::TabHelper::GetActiveTabIdForWindow(window_id);
+}
 #endif
 
 bool WebContents::SendIPCMessage(bool all_frames,
                                  const base::string16& channel,
                                  const base::ListValue& args) {
+  // Batches go to the same frames as |all_frames| = false, since the renderer
+  // doesn't tell the two apart.
+  auto batching = ipc_batching_.find(channel);
+  if (batching != ipc_batching_.end()) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (ipc_batch_.Add(channel, args, batching->second.coalesce,
+                       now + batching->second.interval)) {
+      // The batch goes out when the channel with the shortest interval is
+      // due.
+      ipc_batch_timer_.Start(FROM_HERE, ipc_batch_.deadline() - now,
+                             base::Bind(&WebContents::FlushIPCBatch,
+                                        base::Unretained(this)));
+    }
+    return true;
+  }
   return Send(new AtomViewMsg_Message(routing_id(), all_frames, channel, args));
 }
 
+void WebContents::SetIPCBatching(const base::string16& channel,
+                                 mate::Arguments* args) {
+  mate::Dictionary options;
+  if (!args->GetNext(&options)) {
+    ipc_batching_.erase(channel);
+    return;
+  }
+
+  IPCBatchingOptions batching;
+  options.Get("coalesce", &batching.coalesce);
+  int interval_ms = 0;
+  options.Get("interval", &interval_ms);
+  batching.interval =
+      base::TimeDelta::FromMilliseconds(std::max(interval_ms, 0));
+  ipc_batching_[channel] = batching;
+}
+
+void WebContents::FlushIPCBatch() {
+  if (ipc_batch_.empty())
+    return;
+  Send(new AtomViewMsg_MessageBatch(routing_id(), *ipc_batch_.Take()));
+}
+
+void WebContents::DiscardIPCBatch() {
+  ipc_batch_timer_.Stop();
+  ipc_batch_.Take();
+}
+
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
   const auto view = web_contents()->GetRenderWidgetHostView();
@@ -2070,6 +2209,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isFocused", &WebContents::IsFocused)
       .SetMethod("_clone", &WebContents::Clone)
       .SetMethod("_send", &WebContents::SendIPCMessage)
+      .SetMethod("setIPCBatching", &WebContents::SetIPCBatching)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("setSize", &WebContents::SetSize)
@@ -2115,6 +2255,9 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
 #if BUILDFLAG(ENABLE_EXTENSIONS)
       .SetMethod("executeScriptInTab", &WebContents::ExecuteScriptInTab)
       .SetMethod("setTabValues", &WebContents::SetTabValues)
+      .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("isDiscarded", &WebContents::IsDiscarded)
+      .SetMethod("setAutoDiscardable", &WebContents::SetAutoDiscardable)
       .SetMethod("isBackgroundPage", &WebContents::IsBackgroundPage)
       .SetMethod("tabValue", &WebContents::TabValue)
 #endif
@@ -2145,6 +2288,11 @@ void WebContents::OnRendererMessageSync(const base::string16& channel,
   EmitWithSender(base::UTF16ToUTF8(channel), web_contents(), message, args);
 }
 
+void WebContents::OnRendererMessageBatch(const base::ListValue& batch) {
+  // webContents.emit('ipc-message-batch', new Event(), batch);
+  Emit("ipc-message-batch", batch);
+}
+
 // static
 mate::Handle<WebContents> WebContents::FromTabID(v8::Isolate* isolate,
     int tab_id) {
@@ -2290,10 +2438,108 @@ mate::Handle<WebContents> WebContents::CreateFrom(
         type));
 }
 
+// static
+v8::Local<v8::Value> WebContents::GetAllWebContentsInfo(
+    v8::Isolate* isolate, mate::Arguments* args) {
+  int fields = kDefaultInfoFields;
+  v8::Local<v8::Value> type_filter;
+  int32_t owner_window_id = 0;
+
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    std::vector<std::string> field_names;
+    if (options.Get("fields", &field_names)) {
+      fields = 0;
+      for (const std::string& name : field_names) {
+        bool found = false;
+        for (const auto& info_field : kInfoFields) {
+          if (name == info_field.name) {
+            fields |= info_field.field;
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          args->ThrowError("Unknown field: " + name);
+          return v8::Undefined(isolate);
+        }
+      }
+    }
+    options.Get("type", &type_filter);
+    options.Get("ownerWindowId", &owner_window_id);
+  }
+
+  std::vector<mate::Dictionary> infos;
+  for (WebContents* contents : GetAllNative(isolate)) {
+    if (!contents->web_contents())
+      continue;
+    v8::Local<v8::Value> type = mate::ConvertToV8(isolate, contents->GetType());
+    if (!type_filter.IsEmpty() && !type->StrictEquals(type_filter))
+      continue;
+    int32_t window_id = GetOwnerWindowId(contents->owner_window());
+    if (owner_window_id && window_id != owner_window_id)
+      continue;
+
+    mate::Dictionary info = mate::Dictionary::CreateEmpty(isolate);
+    if (fields & INFO_ID)
+      info.Set("id", contents->GetID());
+    if (fields & INFO_TYPE)
+      info.Set("type", type);
+    if (fields & INFO_URL)
+      info.Set("url", contents->GetURL());
+    if (fields & INFO_TITLE)
+      info.Set("title", contents->GetTitle());
+    if (fields & INFO_IS_LOADING)
+      info.Set("isLoading", contents->IsLoading());
+    if (fields & INFO_IS_CRASHED)
+      info.Set("isCrashed", contents->IsCrashed());
+    if (fields & INFO_IS_FOCUSED)
+      info.Set("isFocused", contents->IsFocused());
+    if (fields & INFO_IS_AUDIO_MUTED)
+      info.Set("isAudioMuted", contents->IsAudioMuted());
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+    if (fields & INFO_IS_DISCARDED)
+      info.Set("isDiscarded", contents->IsDiscarded());
+#endif
+    if (fields & INFO_GUEST_INSTANCE_ID)
+      info.Set("guestInstanceId", contents->GetGuestInstanceId());
+    if (fields & INFO_OWNER_WINDOW_ID)
+      info.Set("ownerWindowId", window_id);
+    infos.push_back(info);
+  }
+  return mate::ConvertToV8(isolate, infos);
+}
+
 // static
 mate::Handle<WebContents> WebContents::Create(
     v8::Isolate* isolate, const mate::Dictionary& options) {
-  return mate::CreateHandle(isolate, new WebContents(isolate, options));
+  // Nothing is created, not even in another session, until the session's
+  // partition is ready.
+  mate::Handle<api::Session> session = GetSessionFromOptions(isolate, options);
+  if (session.IsEmpty())
+    return mate::Handle<WebContents>();
+
+  content::WebContents::CreateParams create_params(session->browser_context());
+  return CreateWithParams(isolate, options, create_params);
+}
+
+// static
+mate::Handle<api::Session> WebContents::GetSessionFromOptions(
+    v8::Isolate* isolate, const mate::Dictionary& options) {
+  mate::Handle<api::Session> session;
+  std::string partition;
+  if (options.Get("partition", &session)) {
+  } else if (options.Get("partition", &partition)) {
+    session = Session::FromPartition(isolate, partition);
+  } else {
+    // Use the default session if not specified.
+    session = Session::FromPartition(isolate, "");
+  }
+  if (session.IsEmpty()) {
+    isolate->ThrowException(v8::Exception::Error(mate::StringToV8(
+        isolate, "Session is still loading, use session.fromPartitionAsync")));
+  }
+  return session;
 }
 
 mate::Handle<WebContents> WebContents::CreateWithParams(
@@ -2319,9 +2565,16 @@ void Initialize(v8::Local<v8::Object> exports, v8::Local<v8::Value> unused,
   dict.SetMethod("create", &WebContents::Create);
   dict.SetMethod("createTab", &WebContents::CreateTab);
   dict.SetMethod("fromTabID", &WebContents::FromTabID);
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  dict.SetMethod("setMaxLiveTabs", &WebContents::SetMaxLiveTabs);
+  dict.SetMethod("getTabIDsForWindow", &WebContents::GetTabIDsForWindow);
+  dict.SetMethod("getActiveTabIDForWindow",
+                 &WebContents::GetActiveTabIDForWindow);
+#endif
   dict.SetMethod("fromId", &mate::TrackableObject<WebContents>::FromWeakMapID);
   dict.SetMethod("getAllWebContents",
                  &mate::TrackableObject<WebContents>::GetAll);
+  dict.SetMethod("getAllWebContentsInfo", &WebContents::GetAllWebContentsInfo);
 }
 
 }  // namespace
@@ -5,6 +5,7 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 #define ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -12,8 +13,10 @@
 #include "atom/browser/api/save_page_handler.h"
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/common_web_contents_delegate.h"
+#include "atom/common/api/ipc_message_batch.h"
 #include "atom/common/options_switches.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/timer/timer.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/common/view_messages.h"
 #include "content/public/browser/web_contents_observer.h"
@@ -92,6 +95,8 @@ class AtomBrowserContext;
 
 namespace api {
 
+class Session;
+
 class WebContents : public mate::TrackableObject<WebContents>,
                     public CommonWebContentsDelegate,
                     public content::WebContentsObserver {
@@ -110,19 +115,34 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Get the webcontents by tabId.
   static mate::Handle<WebContents> FromTabID(
     v8::Isolate* isolate, int tab_id);
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  static void SetMaxLiveTabs(int max_live_tabs);
+  static std::vector<int32_t> GetTabIDsForWindow(int32_t window_id);
+  static int32_t GetActiveTabIDForWindow(int32_t window_id);
+#endif
 
   static void CreateTab(mate::Arguments* args);
 
+  // Returns selected fields of all WebContents in a single call.
+  static v8::Local<v8::Value> GetAllWebContentsInfo(v8::Isolate* isolate,
+                                                    mate::Arguments* args);
+
   static mate::Handle<WebContents> CreateFrom(
       v8::Isolate* isolate, content::WebContents* web_contents);
 
   static mate::Handle<WebContents> CreateFrom(
       v8::Isolate* isolate, content::WebContents* web_contents, Type type);
 
-  // Create a new WebContents.
+  // Create a new WebContents. Throws and returns an empty handle if the
+  // session of the requested partition is still loading.
   static mate::Handle<WebContents> Create(
       v8::Isolate* isolate, const mate::Dictionary& options);
 
+  // Returns the session named by the partition option, or the default
+  // session. Throws and returns an empty handle if it is still loading.
+  static mate::Handle<Session> GetSessionFromOptions(
+      v8::Isolate* isolate, const mate::Dictionary& options);
+
   static mate::Handle<WebContents> CreateWithParams(
       v8::Isolate* isolate, const mate::Dictionary& options,
       const content::WebContents::CreateParams& create_params);
@@ -228,6 +248,9 @@ class WebContents : public mate::TrackableObject<WebContents>,
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   bool ExecuteScriptInTab(mate::Arguments* args);
   void SetTabValues(const base::DictionaryValue& values);
+  bool Discard();
+  bool IsDiscarded();
+  void SetAutoDiscardable(bool auto_discardable);
 #endif
 
   // Send messages to browser.
@@ -235,6 +258,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
                       const base::string16& channel,
                       const base::ListValue& args);
 
+  // Queues the messages sent on |channel| and sends them in batches. Passing
+  // no options sends them one by one again.
+  void SetIPCBatching(const base::string16& channel, mate::Arguments* args);
+
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
 
@@ -276,7 +303,6 @@ class WebContents : public mate::TrackableObject<WebContents>,
  protected:
   WebContents(v8::Isolate* isolate,
         content::WebContents* web_contents, Type type);
-  WebContents(v8::Isolate* isolate, const mate::Dictionary& options);
   WebContents(v8::Isolate* isolate, const mate::Dictionary& options,
       const content::WebContents::CreateParams& create_params);
   ~WebContents();
@@ -347,6 +373,8 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void CloseContents(content::WebContents* source) override;
   void ActivateContents(content::WebContents* contents) override;
   void UpdateTargetURL(content::WebContents* source, const GURL& url) override;
+  void NavigationStateChanged(content::WebContents* source,
+                              content::InvalidateTypes changed_flags) override;
   void LoadProgressChanged(content::WebContents* source,
                                    double progress) override;
   bool IsPopupOrPanel(const content::WebContents* source) const override;
@@ -390,6 +418,8 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void BeforeUnloadFired(const base::TimeTicks& proceed_time) override;
   void RenderViewReady() override;
   void RenderViewDeleted(content::RenderViewHost*) override;
+  void RenderViewHostChanged(content::RenderViewHost* old_host,
+                             content::RenderViewHost* new_host) override;
   void RenderProcessGone(base::TerminationStatus status) override;
   void DocumentAvailableInMainFrame() override;
   void DocumentOnLoadCompletedInMainFrame() override;
@@ -404,6 +434,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
                    bool was_ignored_by_handler) override;
   void DidStartLoading() override;
   void DidStopLoading() override;
+  void DidGetUserInteraction(const blink::WebInputEvent::Type type) override;
   void DidGetResourceResponseStart(
       const content::ResourceRequestDetails& details) override;
   void DidGetRedirectForResourceRequest(
@@ -468,6 +499,13 @@ class WebContents : public mate::TrackableObject<WebContents>,
                              const base::ListValue& args,
                              IPC::Message* message);
 
+  // Called when received a batch of messages from renderer.
+  void OnRendererMessageBatch(const base::ListValue& batch);
+
+  void FlushIPCBatch();
+  // Drops the queued messages, whose page has gone away.
+  void DiscardIPCBatch();
+
   v8::Global<v8::Value> session_;
   v8::Global<v8::Value> devtools_web_contents_;
   v8::Global<v8::Value> debugger_;
@@ -485,6 +523,18 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
   guest_view::GuestViewBase* guest_delegate_;  // not owned
 
+  struct IPCBatchingOptions {
+    IPCBatchingOptions() : coalesce(false) {}
+
+    // Only the last message of a batch is kept.
+    bool coalesce;
+    // How long a message of the channel may wait for others.
+    base::TimeDelta interval;
+  };
+  std::map<base::string16, IPCBatchingOptions> ipc_batching_;
+  IPCMessageBatch ipc_batch_;
+  base::OneShotTimer ipc_batch_timer_;
+
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
   DISALLOW_COPY_AND_ASSIGN(WebContents);
 };
@@ -6,6 +6,7 @@
 #include "atom/common/native_mate_converters/value_converter.h"
 
 #include "atom/browser/api/atom_api_menu.h"
+#include "atom/browser/api/atom_api_session.h"
 #include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/native_window.h"
@@ -308,6 +309,14 @@ mate::WrappableBase* Window::New(mate::Arguments* args) {
     options = mate::Dictionary::CreateEmpty(args->isolate());
   }
 
+  // Don't create the window while the session of its partition is loading.
+  mate::Dictionary web_preferences =
+      mate::Dictionary::CreateEmpty(args->isolate());
+  options.Get(options::kWebPreferences, &web_preferences);
+  if (WebContents::GetSessionFromOptions(args->isolate(),
+                                         web_preferences).IsEmpty())
+    return nullptr;
+
   return new Window(args->isolate(), args->GetThis(), options);
 }
 
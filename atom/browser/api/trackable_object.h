@@ -95,6 +95,18 @@ class TrackableObject : public TrackableObjectBase,
       return std::vector<v8::Local<v8::Object>>();
   }
 
+  // Returns the native objects of all instances that haven't been destroyed,
+  // so that a collection can be read without a call from JS per object.
+  static std::vector<T*> GetAllNative(v8::Isolate* isolate) {
+    std::vector<T*> objects;
+    for (v8::Local<v8::Object> wrapper : GetAll(isolate)) {
+      T* self = nullptr;
+      if (mate::ConvertFromV8(isolate, wrapper, &self) && self)
+        objects.push_back(self);
+    }
+    return objects;
+  }
+
   // Removes this instance from the weak map.
   void RemoveFromWeakMap() {
     if (weak_map_ && weak_map_->Has(weak_map_id()))
@@ -11,11 +11,13 @@
 #include "atom/browser/bridge_task_runner.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/browser_context_keyed_service_factories.h"
+#include "atom/browser/idle_gc_scheduler.h"
 #include "atom/browser/javascript_environment.h"
 #include "atom/browser/node_debugger.h"
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/startup_timeline.h"
 #include "base/allocator/allocator_extension.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
@@ -23,6 +25,7 @@
 #include "base/memory/memory_pressure_monitor.h"
 #include "base/path_service.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "brave/common/extensions/asar_source_map.h"
 #include "brightray/browser/brightray_paths.h"
 #include "browser/media/media_capture_devices_dispatcher.h"
 #include "chrome/browser/browser_process.h"
@@ -70,8 +73,7 @@ AtomBrowserMainParts::AtomBrowserMainParts()
       exit_code_(nullptr),
       browser_(new Browser),
       node_bindings_(NodeBindings::Create(true)),
-      atom_bindings_(new AtomBindings),
-      gc_timer_(true, true) {
+      atom_bindings_(new AtomBindings) {
   DCHECK(!self_) << "Cannot have two AtomBrowserMainParts";
   self_ = this;
 }
@@ -139,24 +141,28 @@ void AtomBrowserMainParts::OnMemoryPressure(
   if (atom::Browser::Get()->is_shutting_down())
     return;
 
+  brave::AsarSourceMap::ClearCache();
   base::allocator::ReleaseFreeMemory();
 
-  if (js_env_.get() && js_env_->isolate()) {
-    js_env_->isolate()->LowMemoryNotification();
-  }
+  if (idle_gc_scheduler_)
+    idle_gc_scheduler_->OnMemoryPressure(memory_pressure_level);
 }
 
-void AtomBrowserMainParts::IdleHandler() {
+void AtomBrowserMainParts::OnIdleGCDone() {
   base::allocator::ReleaseFreeMemory();
 }
 
 void AtomBrowserMainParts::PreMainMessageLoopRun() {
+  StartupTimeline::ScopedPhase phase("PreMainMessageLoopRun");
   fake_browser_process_->PreMainMessageLoopRun();
 
   content::WebUIControllerFactory::RegisterFactory(
       ChromeWebUIControllerFactory::GetInstance());
 
-  js_env_.reset(new JavascriptEnvironment);
+  {
+    StartupTimeline::ScopedPhase phase("JavascriptEnvironment");
+    js_env_.reset(new JavascriptEnvironment);
+  }
   js_env_->isolate()->Enter();
 
   node_bindings_->Initialize();
@@ -176,7 +182,10 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
   atom_bindings_->BindTo(js_env_->isolate(), env->process_object());
 
   // Load everything.
-  node_bindings_->LoadEnvironment(env);
+  {
+    StartupTimeline::ScopedPhase phase("LoadEnvironment");
+    node_bindings_->LoadEnvironment(env);
+  }
 
   // Wrap the uv loop with global env.
   node_bindings_->set_uv_env(env);
@@ -186,10 +195,12 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
 #endif
 
   // Start idle gc.
-  gc_timer_.Start(
-      FROM_HERE, base::TimeDelta::FromMinutes(1),
-      base::Bind(&AtomBrowserMainParts::IdleHandler,
+  idle_gc_scheduler_.reset(new IdleGCScheduler(js_env_->isolate()));
+  idle_gc_scheduler_->set_idle_work_done_callback(
+      base::Bind(&AtomBrowserMainParts::OnIdleGCDone,
                  base::Unretained(this)));
+  // Node's timer and io callbacks don't always run from a task.
+  node_bindings_->AddUvRunObserver(idle_gc_scheduler_.get());
 
   memory_pressure_listener_.reset(new base::MemoryPressureListener(
       base::Bind(&AtomBrowserMainParts::OnMemoryPressure,
@@ -245,6 +256,8 @@ void AtomBrowserMainParts::PostMainMessageLoopRun() {
   browser_context_ = nullptr;
   brightray::BrowserMainParts::PostMainMessageLoopRun();
 
+  node_bindings_->RemoveUvRunObserver(idle_gc_scheduler_.get());
+  idle_gc_scheduler_.reset();
   js_env_->OnMessageLoopDestroying();
 
   js_env_->isolate()->Exit();
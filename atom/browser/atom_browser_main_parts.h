@@ -11,7 +11,6 @@
 
 #include "base/callback.h"
 #include "base/memory/memory_pressure_listener.h"
-#include "base/timer/timer.h"
 #include "brightray/browser/browser_main_parts.h"
 #include "content/public/browser/browser_context.h"
 
@@ -25,6 +24,7 @@ namespace atom {
 
 class AtomBindings;
 class Browser;
+class IdleGCScheduler;
 class JavascriptEnvironment;
 class NodeBindings;
 class NodeDebugger;
@@ -49,6 +49,7 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
   base::Closure RegisterDestructionCallback(const base::Closure& callback);
 
   Browser* browser() { return browser_.get(); }
+  NodeBindings* node_bindings() { return node_bindings_.get(); }
 
  protected:
   // content::BrowserMainParts:
@@ -65,7 +66,7 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
 
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
-  void IdleHandler();
+  void OnIdleGCDone();
 
  private:
 #if defined(OS_POSIX)
@@ -96,7 +97,7 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
   std::unique_ptr<AtomBindings> atom_bindings_;
   std::unique_ptr<NodeDebugger> node_debugger_;
 
-  base::Timer gc_timer_;
+  std::unique_ptr<IdleGCScheduler> idle_gc_scheduler_;
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   // List of callbacks should be executed before destroying JS env.
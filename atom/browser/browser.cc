@@ -10,6 +10,7 @@
 #include "atom/browser/browser_observer.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/window_list.h"
+#include "atom/common/startup_timeline.h"
 #include "base/files/file_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
@@ -153,6 +154,8 @@ void Browser::WillFinishLaunching() {
 }
 
 void Browser::DidFinishLaunching(const base::DictionaryValue& launch_info) {
+  // Covers the app's 'ready' handlers.
+  StartupTimeline::ScopedPhase phase("DidFinishLaunching");
   is_ready_ = true;
   for (BrowserObserver& observer : observers_)
     observer.OnFinishLaunching(launch_info);
@@ -445,6 +445,7 @@ void CommonWebContentsDelegate::DevToolsRemoveFileSystem(
   std::string path = file_system_path.AsUTF8Unsafe();
   storage::IsolatedContext::GetInstance()->
       RevokeFileSystemByPath(file_system_path);
+  devtools_file_system_indexer_->StopWatching(path);
 
   auto pref_service = GetPrefService(GetDevToolsWebContents());
   DictionaryPrefUpdate update(pref_service, prefs::kDevToolsFileSystemPaths);
@@ -5,18 +5,22 @@
 #include "atom/browser/extensions/tab_helper.h"
 
 #include <map>
+#include <set>
 #include <utility>
+#include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/extensions/atom_extension_api_frame_id_map_helper.h"
 #include "atom/browser/extensions/atom_extension_web_contents_observer.h"
+#include "atom/browser/extensions/tab_lifecycle_manager.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/lazy_instance.h"
+#include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
-#include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
 #include "extensions/browser/component_extension_resource_manager.h"
 #include "extensions/browser/extension_registry.h"
@@ -47,19 +51,87 @@ const char kPinnedKey[] = "pinned";
 const char kSelectedKey[] = "selected";
 }  // namespace keys
 
-static std::map<int, std::pair<int, int>> render_view_map_;
-static std::map<int, int> active_tab_map_;
 static int32_t next_id = 1;
 
 namespace extensions {
 
+namespace {
+
+// Every live TabHelper by tab id, the tabs of each window and the active tab
+// of each window.
+struct TabRegistry {
+  std::map<int32_t, TabHelper*> tabs;
+  std::map<int32_t, std::set<int32_t>> window_tabs;
+  std::map<int32_t, int32_t> active_tabs;
+};
+
+base::LazyInstance<TabRegistry>::Leaky g_tab_registry =
+    LAZY_INSTANCE_INITIALIZER;
+
+TabHelper* GetTabHelper(int32_t tab_id) {
+  auto it = g_tab_registry.Get().tabs.find(tab_id);
+  return it == g_tab_registry.Get().tabs.end() ? nullptr : it->second;
+}
+
+int32_t GetActiveTabId(int32_t window_id) {
+  auto it = g_tab_registry.Get().active_tabs.find(window_id);
+  return it == g_tab_registry.Get().active_tabs.end() ? -1 : it->second;
+}
+
+void AddToWindow(int32_t tab_id, int32_t window_id) {
+  g_tab_registry.Get().window_tabs[window_id].insert(tab_id);
+}
+
+void RemoveFromWindow(int32_t tab_id, int32_t window_id) {
+  TabRegistry& registry = g_tab_registry.Get();
+  auto it = registry.window_tabs.find(window_id);
+  if (it == registry.window_tabs.end())
+    return;
+  it->second.erase(tab_id);
+  if (it->second.empty())
+    registry.window_tabs.erase(it);
+
+  auto active = registry.active_tabs.find(window_id);
+  if (active != registry.active_tabs.end() && active->second == tab_id)
+    registry.active_tabs.erase(active);
+}
+
+void RemoveFromRegistry(int32_t tab_id, int32_t window_id) {
+  g_tab_registry.Get().tabs.erase(tab_id);
+  RemoveFromWindow(tab_id, window_id);
+}
+
+// Keys that CreateTabValue computes, which take precedence over the values
+// set with SetTabValues.
+const char* const kComputedKeys[] = {
+  keys::kIdKey, keys::kWindowIdKey, keys::kIncognitoKey, keys::kActiveKey,
+  keys::kUrlKey, keys::kTitleKey, keys::kStatusKey, keys::kAudibleKey,
+  keys::kDiscardedKey, keys::kAutoDiscardableKey, keys::kHighlightedKey,
+  keys::kIndexKey, keys::kPinnedKey, keys::kSelectedKey,
+};
+
+bool IsComputedKey(const std::string& key) {
+  for (const char* computed_key : kComputedKeys) {
+    if (key == computed_key)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 TabHelper::TabHelper(content::WebContents* contents)
     : content::WebContentsObserver(contents),
       values_(new base::DictionaryValue),
+      tab_value_(new base::DictionaryValue),
       script_executor_(
           new ScriptExecutor(contents, &script_execution_observers_)) {
   session_id_ = next_id++;
-  RenderViewCreated(contents->GetRenderViewHost());
+  last_active_time_ = base::TimeTicks::Now();
+  g_tab_registry.Get().tabs[session_id_] = this;
+  AddToWindow(session_id_, window_id_);
+  TabLifecycleManager::GetInstance()->AddTab(this);
+  RefreshTabValue(nullptr);
   contents->ForEachFrame(
       base::Bind(&TabHelper::SetTabId, base::Unretained(this)));
 
@@ -67,43 +139,238 @@ TabHelper::TabHelper(content::WebContents* contents)
 }
 
 TabHelper::~TabHelper() {
+  RemoveFromRegistry(session_id_, window_id_);
+  TabLifecycleManager::GetInstance()->RemoveTab(this);
 }
 
 void TabHelper::SetWindowId(const int32_t& id) {
+  if (id != window_id_) {
+    RemoveFromWindow(session_id_, window_id_);
+    AddToWindow(session_id_, id);
+  }
   window_id_ = id;
   // Extension code in the renderer holds the ID of the window that hosts it.
   // Notify it that the window ID changed.
   web_contents()->SendToAllFrames(
       new ExtensionMsg_UpdateBrowserWindowId(MSG_ROUTING_NONE, window_id_));
+  UpdateTabValue();
 }
 
 void TabHelper::SetActive(bool active) {
-  if (active)
-    active_tab_map_[window_id_] = session_id_;
-  else if (active_tab_map_[window_id_] == session_id_)
-    active_tab_map_[window_id_] = -1;
+  std::map<int32_t, int32_t>& active_tabs = g_tab_registry.Get().active_tabs;
+  int32_t previous_active_tab = GetActiveTabId(window_id_);
+  if (active) {
+    active_tabs[window_id_] = session_id_;
+  } else if (previous_active_tab == session_id_) {
+    active_tabs.erase(window_id_);
+  }
+  last_active_time_ = base::TimeTicks::Now();
+
+  if (active && discarded_) {
+    discarded_ = false;
+    web_contents()->GetController().LoadIfNecessary();
+  }
+  UpdateTabValue();
+
+  // The tab this one replaced is no longer active either.
+  if (active && previous_active_tab != session_id_) {
+    TabHelper* previous_tab = GetTabHelper(previous_active_tab);
+    if (previous_tab)
+      previous_tab->UpdateTabValue();
+  }
 }
 
 void TabHelper::SetTabIndex(int index) {
   index_ = index;
+  UpdateTabValue();
 }
 
 void TabHelper::SetTabValues(const base::DictionaryValue& values) {
   values_->MergeDictionary(&values);
+
+  base::DictionaryValue changes;
+  for (base::DictionaryValue::Iterator it(values); !it.IsAtEnd();
+       it.Advance()) {
+    const base::Value* value = nullptr;
+    if (!IsComputedKey(it.key()) &&
+        values_->GetWithoutPathExpansion(it.key(), &value)) {
+      SetTabValueField(it.key(), value->CreateDeepCopy(), &changes);
+    }
+  }
+  // Computed fields such as pinned can depend on the values.
+  RefreshTabValue(&changes);
+  NotifyTabValueChanged(changes);
+}
+
+bool TabHelper::Discard() {
+  if (!CanDiscard())
+    return false;
+
+  // RenderProcessGone checks this to tell a discard from a crash.
+  discarded_ = true;
+  if (!web_contents()->GetRenderProcessHost()->FastShutdownIfPossible(
+          1u, false)) {
+    discarded_ = false;
+    return false;
+  }
+
+  web_contents()->GetController().SetNeedsReload();
+  UpdateTabValue();
+  return true;
+}
+
+bool TabHelper::CanDiscard() const {
+  return HasLiveRenderer() && !IsActive();
+}
+
+bool TabHelper::HasLiveRenderer() const {
+  if (!web_contents() || discarded_)
+    return false;
+
+  content::RenderProcessHost* host = web_contents()->GetRenderProcessHost();
+  return host && host->HasConnection();
+}
+
+void TabHelper::SetAutoDiscardable(bool auto_discardable) {
+  auto_discardable_ = auto_discardable;
+  UpdateTabValue();
+}
+
+bool TabHelper::IsActive() const {
+  return GetActiveTabId(window_id_) == session_id_;
+}
+
+bool TabHelper::IsAudible() const {
+  return web_contents() && web_contents()->WasRecentlyAudible();
+}
+
+void TabHelper::OnAudioStateChanged(bool audible) {
+  base::DictionaryValue changes;
+  SetTabValueField(keys::kAudibleKey,
+      base::MakeUnique<base::FundamentalValue>(audible), &changes);
+  NotifyTabValueChanged(changes);
 }
 
-void TabHelper::RenderViewCreated(content::RenderViewHost* render_view_host) {
-  render_view_map_[session_id_] = std::make_pair(
-      render_view_host->GetProcess()->GetID(),
-      render_view_host->GetRoutingID());
+bool TabHelper::IsPinned() const {
+  bool pinned = false;
+  values_->GetBooleanWithoutPathExpansion(keys::kPinnedKey, &pinned);
+  return pinned;
 }
 
 void TabHelper::RenderFrameCreated(content::RenderFrameHost* host) {
   SetTabId(host);
+
+  // The number of live renderers only grows when a tab gets a new one.
+  if (!host->GetParent())
+    TabLifecycleManager::GetInstance()->EnforceMaxLiveTabs();
+}
+
+void TabHelper::DidStartLoading() {
+  UpdateTabValue();
+}
+
+void TabHelper::DidStopLoading() {
+  UpdateTabValue();
+}
+
+void TabHelper::DidStartNavigation(
+    content::NavigationHandle* navigation_handle) {
+  // Navigating brings up a new renderer.
+  discarded_ = false;
+  UpdateTabValue();
+}
+
+void TabHelper::DidFinishNavigation(
+    content::NavigationHandle* navigation_handle) {
+  UpdateTabValue();
+}
+
+void TabHelper::TitleWasSet(content::NavigationEntry* entry,
+                            bool explicit_set) {
+  UpdateTabValue();
 }
 
 void TabHelper::WebContentsDestroyed() {
-  render_view_map_.erase(session_id_);
+  RemoveFromRegistry(session_id_, window_id_);
+  TabLifecycleManager::GetInstance()->RemoveTab(this);
+}
+
+void TabHelper::SetTabValueField(const std::string& key,
+                                 std::unique_ptr<base::Value> value,
+                                 base::DictionaryValue* changes) {
+  const base::Value* current = nullptr;
+  if (tab_value_->GetWithoutPathExpansion(key, &current) &&
+      current->Equals(value.get()))
+    return;
+  if (changes)
+    changes->SetWithoutPathExpansion(key, value->CreateDeepCopy());
+  tab_value_->SetWithoutPathExpansion(key, std::move(value));
+}
+
+void TabHelper::RefreshTabValue(base::DictionaryValue* changes) {
+  content::WebContents* contents = web_contents();
+  if (!contents)
+    return;
+
+  bool active = IsActive();
+  std::string status = "complete";
+  if (discarded_)
+    status = "unloaded";
+  else if (contents->IsLoading())
+    status = "loading";
+  auto entry = contents->GetController().GetLastCommittedEntry();
+
+  SetTabValueField(keys::kIdKey,
+      base::MakeUnique<base::FundamentalValue>(session_id_), changes);
+  SetTabValueField(keys::kWindowIdKey,
+      base::MakeUnique<base::FundamentalValue>(window_id_), changes);
+  SetTabValueField(keys::kIncognitoKey,
+      base::MakeUnique<base::FundamentalValue>(
+          contents->GetBrowserContext()->IsOffTheRecord()), changes);
+  SetTabValueField(keys::kActiveKey,
+      base::MakeUnique<base::FundamentalValue>(active), changes);
+  SetTabValueField(keys::kUrlKey,
+      base::MakeUnique<base::StringValue>(contents->GetURL().spec()),
+      changes);
+  SetTabValueField(keys::kTitleKey,
+      base::MakeUnique<base::StringValue>(
+          entry ? base::UTF16ToUTF8(entry->GetTitle()) : ""), changes);
+  SetTabValueField(keys::kStatusKey,
+      base::MakeUnique<base::StringValue>(status), changes);
+  SetTabValueField(keys::kAudibleKey,
+      base::MakeUnique<base::FundamentalValue>(
+          contents->WasRecentlyAudible()), changes);
+  SetTabValueField(keys::kDiscardedKey,
+      base::MakeUnique<base::FundamentalValue>(discarded_), changes);
+  SetTabValueField(keys::kAutoDiscardableKey,
+      base::MakeUnique<base::FundamentalValue>(auto_discardable_), changes);
+  SetTabValueField(keys::kHighlightedKey,
+      base::MakeUnique<base::FundamentalValue>(active), changes);
+  SetTabValueField(keys::kIndexKey,
+      base::MakeUnique<base::FundamentalValue>(index_), changes);
+  SetTabValueField(keys::kPinnedKey,
+      base::MakeUnique<base::FundamentalValue>(IsPinned()), changes);
+  SetTabValueField(keys::kSelectedKey,
+      base::MakeUnique<base::FundamentalValue>(active), changes);
+}
+
+void TabHelper::UpdateTabValue() {
+  base::DictionaryValue changes;
+  RefreshTabValue(&changes);
+  NotifyTabValueChanged(changes);
+}
+
+void TabHelper::NotifyTabValueChanged(const base::DictionaryValue& changes) {
+  if (changes.empty() || !web_contents())
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  auto api_web_contents =
+      atom::api::WebContents::FromWrappedClass(isolate, web_contents());
+  if (api_web_contents)
+    api_web_contents->Emit("tab-value-changed", changes, *tab_value_);
 }
 
 void TabHelper::SetTabId(content::RenderFrameHost* render_frame_host) {
@@ -265,14 +532,8 @@ void TabHelper::ExecuteScript(
 
 // static
 content::WebContents* TabHelper::GetTabById(int32_t tab_id) {
-  content::RenderViewHost* rvh =
-      content::RenderViewHost::FromID(render_view_map_[tab_id].first,
-                                      render_view_map_[tab_id].second);
-  if (rvh) {
-    return content::WebContents::FromRenderViewHost(rvh);
-  } else {
-    return NULL;
-  }
+  TabHelper* tab_helper = GetTabHelper(tab_id);
+  return tab_helper ? tab_helper->web_contents() : NULL;
 }
 
 // static
@@ -293,36 +554,22 @@ content::WebContents* TabHelper::GetTabById(int32_t tab_id,
 // static
 base::DictionaryValue* TabHelper::CreateTabValue(
                                               content::WebContents* contents) {
-  auto tab_id = IdForTab(contents);
-  auto window_id = IdForWindowContainingTab(contents);
   auto tab_helper = TabHelper::FromWebContents(contents);
+  return tab_helper->tab_value_->DeepCopy();
+}
 
-  bool active = (active_tab_map_[window_id] == tab_id);
-  std::unique_ptr<base::DictionaryValue> result(
-      tab_helper->getTabValues()->CreateDeepCopy());
-
-  auto entry = contents->GetController().GetLastCommittedEntry();
+// static
+std::vector<int32_t> TabHelper::GetTabIdsForWindow(int32_t window_id) {
+  const TabRegistry& registry = g_tab_registry.Get();
+  auto it = registry.window_tabs.find(window_id);
+  if (it == registry.window_tabs.end())
+    return std::vector<int32_t>();
+  return std::vector<int32_t>(it->second.begin(), it->second.end());
+}
 
-  result->SetInteger(keys::kIdKey, tab_id);
-  result->SetInteger(keys::kWindowIdKey, window_id);
-  result->SetBoolean(keys::kIncognitoKey,
-                     contents->GetBrowserContext()->IsOffTheRecord());
-  result->SetBoolean(keys::kActiveKey, active);
-  result->SetString(keys::kUrlKey, contents->GetURL().spec());
-  result->SetString(keys::kTitleKey,
-                    entry ? base::UTF16ToUTF8(entry->GetTitle()) : "");
-  result->SetString(keys::kStatusKey, contents->IsLoading()
-      ? "loading" : "complete");
-  result->SetBoolean(keys::kAudibleKey, contents->WasRecentlyAudible());
-  result->SetBoolean(keys::kDiscardedKey, false);
-  result->SetBoolean(keys::kAutoDiscardableKey, false);
-  result->SetBoolean(keys::kHighlightedKey, active);
-  result->SetInteger(keys::kIndexKey, tab_helper->index_);
-  // TODO(bridiver) - set pinned value
-  result->SetBoolean(keys::kPinnedKey, false);
-  result->SetBoolean(keys::kSelectedKey, active);
-
-  return result.release();
+// static
+int32_t TabHelper::GetActiveTabIdForWindow(int32_t window_id) {
+  return GetActiveTabId(window_id);
 }
 
 // static
@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "extensions/browser/extension_function_dispatcher.h"
@@ -17,12 +19,14 @@
 
 namespace base {
 class DictionaryValue;
+class Value;
 }
 
 namespace content {
 class BrowserContext;
+class NavigationEntry;
+class NavigationHandle;
 class RenderFrameHost;
-class RenderViewHost;
 }
 
 namespace mate {
@@ -68,6 +72,28 @@ class TabHelper : public content::WebContentsObserver,
     return values_.get();
   }
 
+  // Shuts down the tab's renderer while keeping its navigation state. The
+  // tab is reloaded the next time it is activated. Returns false if the tab
+  // is active or shares its renderer process with other pages.
+  bool Discard();
+  bool CanDiscard() const;
+  bool IsDiscarded() const { return discarded_; }
+  // Whether the tab's renderer is running. Tabs that were never loaded don't
+  // have one yet.
+  bool HasLiveRenderer() const;
+
+  // Whether the TabLifecycleManager may discard the tab on its own.
+  void SetAutoDiscardable(bool auto_discardable);
+  bool IsAutoDiscardable() const { return auto_discardable_; }
+
+  bool IsActive() const;
+  bool IsAudible() const;
+  // Called by the WebContentsDelegate when the tab starts or stops playing
+  // audio.
+  void OnAudioStateChanged(bool audible);
+  bool IsPinned() const;
+  base::TimeTicks last_active_time() const { return last_active_time_; }
+
   bool ExecuteScriptInTab(mate::Arguments* args);
 
   ScriptExecutor* script_executor() {
@@ -88,6 +114,14 @@ class TabHelper : public content::WebContentsObserver,
   static int32_t IdForWindowContainingTab(
       const content::WebContents* tab);
 
+  // Returns the ids of the tabs in the window, in ascending order.
+  static std::vector<int32_t> GetTabIdsForWindow(int32_t window_id);
+  // Returns the id of the window's active tab, or -1 if it has none.
+  static int32_t GetActiveTabIdForWindow(int32_t window_id);
+
+  // Returns a copy of the tab's cached chrome.tabs.Tab value. Whenever fields
+  // of that value change, the api::WebContents emits "tab-value-changed" with
+  // the changed fields and the full value.
   static base::DictionaryValue* CreateTabValue(
       content::WebContents* web_contents);
 
@@ -104,9 +138,25 @@ class TabHelper : public content::WebContentsObserver,
       bool success,
       std::unique_ptr<std::string> code_string);
 
+  // Sets |key| in |tab_value_| and records it in |changes| (if not null)
+  // when the value differs from the cached one.
+  void SetTabValueField(const std::string& key,
+                        std::unique_ptr<base::Value> value,
+                        base::DictionaryValue* changes);
+  // Recomputes the fields of |tab_value_| that come from the WebContents.
+  void RefreshTabValue(base::DictionaryValue* changes);
+  void UpdateTabValue();
+  void NotifyTabValueChanged(const base::DictionaryValue& changes);
+
   // content::WebContentsObserver overrides.
-  void RenderViewCreated(content::RenderViewHost* render_view_host) override;
   void RenderFrameCreated(content::RenderFrameHost* host) override;
+  void DidStartLoading() override;
+  void DidStopLoading() override;
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void TitleWasSet(content::NavigationEntry* entry, bool explicit_set) override;
   void WebContentsDestroyed() override;
   void DidCloneToNewWebContents(
       content::WebContents* old_web_contents,
@@ -125,11 +175,17 @@ class TabHelper : public content::WebContentsObserver,
   int32_t window_id_ = -1;
 
   std::unique_ptr<base::DictionaryValue> values_;
+  // |values_| merged with the computed fields, as returned by CreateTabValue.
+  std::unique_ptr<base::DictionaryValue> tab_value_;
   std::unique_ptr<ScriptExecutor> script_executor_;
 
   // Index of the tab within the window
   int index_ = -1;
 
+  bool discarded_ = false;
+  bool auto_discardable_ = true;
+  base::TimeTicks last_active_time_;
+
   DISALLOW_COPY_AND_ASSIGN(TabHelper);
 };
 
@@ -0,0 +1,107 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/extensions/tab_lifecycle_manager.h"
+
+#include <algorithm>
+
+#include "atom/browser/extensions/tab_helper.h"
+#include "base/bind.h"
+
+namespace extensions {
+
+namespace {
+
+base::LazyInstance<TabLifecycleManager>::Leaky g_tab_lifecycle_manager =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Audible and pinned tabs go last, then the least recently active first.
+bool IsBetterDiscardCandidate(TabHelper* a, TabHelper* b) {
+  if (a->IsAudible() != b->IsAudible())
+    return !a->IsAudible();
+  if (a->IsPinned() != b->IsPinned())
+    return !a->IsPinned();
+  return a->last_active_time() < b->last_active_time();
+}
+
+}  // namespace
+
+// static
+TabLifecycleManager* TabLifecycleManager::GetInstance() {
+  return g_tab_lifecycle_manager.Pointer();
+}
+
+TabLifecycleManager::TabLifecycleManager()
+    : max_live_tabs_(0) {
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&TabLifecycleManager::OnMemoryPressure,
+        base::Unretained(this))));
+}
+
+TabLifecycleManager::~TabLifecycleManager() {
+}
+
+void TabLifecycleManager::AddTab(TabHelper* tab) {
+  tabs_.insert(tab);
+}
+
+void TabLifecycleManager::RemoveTab(TabHelper* tab) {
+  tabs_.erase(tab);
+}
+
+void TabLifecycleManager::SetMaxLiveTabs(size_t max_live_tabs) {
+  max_live_tabs_ = max_live_tabs;
+  EnforceMaxLiveTabs();
+}
+
+void TabLifecycleManager::EnforceMaxLiveTabs() {
+  if (max_live_tabs_ == 0)
+    return;
+
+  size_t live_tabs = GetLiveTabCount();
+  if (live_tabs <= max_live_tabs_)
+    return;
+
+  for (TabHelper* tab : GetDiscardCandidates(false)) {
+    if (tab->Discard() && --live_tabs <= max_live_tabs_)
+      break;
+  }
+}
+
+std::vector<TabHelper*> TabLifecycleManager::GetDiscardCandidates(
+    bool urgent) const {
+  std::vector<TabHelper*> candidates;
+  for (TabHelper* tab : tabs_) {
+    if (!tab->IsAutoDiscardable() || !tab->CanDiscard())
+      continue;
+    if (!urgent && (tab->IsAudible() || tab->IsPinned()))
+      continue;
+    candidates.push_back(tab);
+  }
+  std::sort(candidates.begin(), candidates.end(), IsBetterDiscardCandidate);
+  return candidates;
+}
+
+size_t TabLifecycleManager::GetLiveTabCount() const {
+  return std::count_if(tabs_.begin(), tabs_.end(),
+      [](TabHelper* tab) { return tab->HasLiveRenderer(); });
+}
+
+void TabLifecycleManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+
+  // Pressure notifications repeat while the pressure lasts, so release one
+  // tab at a time.
+  bool urgent = memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  for (TabHelper* tab : GetDiscardCandidates(urgent)) {
+    if (tab->Discard())
+      break;
+  }
+}
+
+}  // namespace extensions
@@ -0,0 +1,64 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_EXTENSIONS_TAB_LIFECYCLE_MANAGER_H_
+#define ATOM_BROWSER_EXTENSIONS_TAB_LIFECYCLE_MANAGER_H_
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+
+namespace extensions {
+
+class TabHelper;
+
+// Discards the renderers of background tabs when the system is under memory
+// pressure, or when more tabs are loaded than the configured limit allows.
+// Tabs are picked by how long ago they were last active, and audible or
+// pinned tabs are only discarded under critical pressure. Discarded tabs keep
+// their navigation state and are reloaded when they are activated again.
+class TabLifecycleManager {
+ public:
+  static TabLifecycleManager* GetInstance();
+
+  void AddTab(TabHelper* tab);
+  void RemoveTab(TabHelper* tab);
+
+  // Maximum number of tabs with a live renderer, or 0 for no limit.
+  void SetMaxLiveTabs(size_t max_live_tabs);
+  size_t max_live_tabs() const { return max_live_tabs_; }
+
+  // Discards background tabs until the number of tabs with a live renderer
+  // is within the limit. Runs whenever a tab gets a new renderer.
+  void EnforceMaxLiveTabs();
+
+ private:
+  friend struct base::DefaultLazyInstanceTraits<TabLifecycleManager>;
+
+  TabLifecycleManager();
+  ~TabLifecycleManager();
+
+  // Returns the tabs that can be discarded, least recently active first.
+  // Audible and pinned tabs are only included if |urgent| is true.
+  std::vector<TabHelper*> GetDiscardCandidates(bool urgent) const;
+  size_t GetLiveTabCount() const;
+
+  void OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  std::set<TabHelper*> tabs_;
+  size_t max_live_tabs_;
+
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(TabLifecycleManager);
+};
+
+}  // namespace extensions
+
+#endif  // ATOM_BROWSER_EXTENSIONS_TAB_LIFECYCLE_MANAGER_H_
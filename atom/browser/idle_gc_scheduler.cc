@@ -0,0 +1,229 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/idle_gc_scheduler.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/threading/thread_local.h"
+#include "base/threading/thread_task_runner_handle.h"
+
+namespace atom {
+
+namespace {
+
+// How long the thread has to go without running a task to count as idle.
+const int kQuietPeriodMs = 100;
+
+// How long idle work is held back after user input.
+const int kInputQuietPeriodMs = 1000;
+
+// Idle slices are kept short so that work arriving during one isn't held up
+// noticeably, and get longer once the thread has been idle for a while.
+const int kIdleSliceMs = 10;
+const int kLongIdleSliceMs = 50;
+const int kLongIdleThresholdMs = 5000;
+
+// How long the thread has to be busy after V8 finished its idle work before
+// it is given idle time again.
+const int kIdleWorkDoneBackoffMs = 30 * 1000;
+
+base::LazyInstance<base::ThreadLocalPointer<IdleGCScheduler>>::Leaky
+    g_scheduler = LAZY_INSTANCE_INITIALIZER;
+
+// V8 expects deadlines in seconds on the platform's monotonic clock, which
+// is base::TimeTicks.
+double ToV8Time(base::TimeTicks time) {
+  return (time - base::TimeTicks()).InSecondsF();
+}
+
+}  // namespace
+
+IdleGCScheduler::Statistics::Statistics()
+    : gc_count(0),
+      major_gc_count(0),
+      idle_gc_count(0),
+      idle_notification_count(0) {
+}
+
+IdleGCScheduler::IdleGCScheduler(v8::Isolate* isolate)
+    : isolate_(isolate),
+      idle_work_done_(false),
+      idle_task_pending_(false),
+      in_idle_task_(false),
+      weak_factory_(this) {
+  DCHECK(!current());
+  g_scheduler.Get().Set(this);
+
+  const v8::GCType gc_types = static_cast<v8::GCType>(
+      v8::kGCTypeScavenge | v8::kGCTypeMarkSweepCompact);
+  isolate_->AddGCPrologueCallback(&IdleGCScheduler::OnGCPrologue, gc_types);
+  isolate_->AddGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue, gc_types);
+
+  base::MessageLoop::current()->AddTaskObserver(this);
+}
+
+IdleGCScheduler::~IdleGCScheduler() {
+  base::MessageLoop::current()->RemoveTaskObserver(this);
+
+  isolate_->RemoveGCPrologueCallback(&IdleGCScheduler::OnGCPrologue);
+  isolate_->RemoveGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue);
+
+  g_scheduler.Get().Set(nullptr);
+}
+
+// static
+IdleGCScheduler* IdleGCScheduler::current() {
+  return g_scheduler.Get().Get();
+}
+
+void IdleGCScheduler::NotifyUserActivity() {
+  last_input_time_ = base::TimeTicks::Now();
+}
+
+void IdleGCScheduler::PostIdleTask(const base::Closure& task) {
+  idle_tasks_.push_back(task);
+  if (!idle_task_pending_)
+    ScheduleIdleTask(base::TimeDelta::FromMilliseconds(kQuietPeriodMs));
+}
+
+void IdleGCScheduler::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Starts incremental marking, which the idle slices then finish.
+      isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+      idle_work_done_ = false;
+      if (!idle_task_pending_)
+        ScheduleIdleTask(base::TimeDelta());
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+      return;
+  }
+}
+
+void IdleGCScheduler::WillProcessTask(const base::PendingTask& pending_task) {
+}
+
+void IdleGCScheduler::DidProcessTask(const base::PendingTask& pending_task) {
+  // The idle task itself doesn't make the thread busy.
+  if (in_idle_task_) {
+    in_idle_task_ = false;
+    return;
+  }
+
+  DidDoWork();
+}
+
+void IdleGCScheduler::DidRunUvLoop() {
+  DidDoWork();
+}
+
+void IdleGCScheduler::DidDoWork() {
+  last_busy_time_ = base::TimeTicks::Now();
+  if (idle_task_pending_)
+    return;
+
+  if (idle_work_done_) {
+    if (last_busy_time_ - idle_work_done_time_ <
+        base::TimeDelta::FromMilliseconds(kIdleWorkDoneBackoffMs))
+      return;
+    idle_work_done_ = false;
+  }
+
+  ScheduleIdleTask(base::TimeDelta::FromMilliseconds(kQuietPeriodMs));
+}
+
+void IdleGCScheduler::ScheduleIdleTask(base::TimeDelta delay) {
+  idle_task_pending_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&IdleGCScheduler::OnIdle, weak_factory_.GetWeakPtr()),
+      delay);
+}
+
+void IdleGCScheduler::OnIdle() {
+  idle_task_pending_ = false;
+  in_idle_task_ = true;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeTicks idle_start = std::max(
+      last_busy_time_ + base::TimeDelta::FromMilliseconds(kQuietPeriodMs),
+      last_input_time_ + base::TimeDelta::FromMilliseconds(
+          kInputQuietPeriodMs));
+  if (idle_start > now) {
+    ScheduleIdleTask(idle_start - now);
+    return;
+  }
+
+  if (!idle_tasks_.empty()) {
+    std::vector<base::Closure> idle_tasks;
+    idle_tasks.swap(idle_tasks_);
+    for (const base::Closure& task : idle_tasks)
+      task.Run();
+    // V8 gets the next idle period rather than what is left of this one.
+    last_busy_time_ = base::TimeTicks::Now();
+    if (!idle_work_done_ || !idle_tasks_.empty())
+      ScheduleIdleTask(base::TimeDelta::FromMilliseconds(kQuietPeriodMs));
+    return;
+  }
+
+  int slice_ms = now - last_busy_time_ >
+      base::TimeDelta::FromMilliseconds(kLongIdleThresholdMs) ?
+      kLongIdleSliceMs : kIdleSliceMs;
+  base::TimeTicks deadline =
+      now + base::TimeDelta::FromMilliseconds(slice_ms);
+
+  v8::HandleScope handle_scope(isolate_);
+  bool done = isolate_->IdleNotificationDeadline(ToV8Time(deadline));
+  ++statistics_.idle_notification_count;
+  statistics_.idle_time += base::TimeTicks::Now() - now;
+
+  if (!done) {
+    ScheduleIdleTask(base::TimeDelta::FromMilliseconds(kQuietPeriodMs));
+    return;
+  }
+
+  idle_work_done_ = true;
+  idle_work_done_time_ = now;
+  if (!idle_work_done_callback_.is_null())
+    idle_work_done_callback_.Run();
+}
+
+// static
+void IdleGCScheduler::OnGCPrologue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags) {
+  IdleGCScheduler* self = current();
+  if (self && self->isolate_ == isolate)
+    self->gc_start_time_ = base::TimeTicks::Now();
+}
+
+// static
+void IdleGCScheduler::OnGCEpilogue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags) {
+  IdleGCScheduler* self = current();
+  if (!self || self->isolate_ != isolate || self->gc_start_time_.is_null())
+    return;
+
+  base::TimeDelta pause = base::TimeTicks::Now() - self->gc_start_time_;
+  self->gc_start_time_ = base::TimeTicks();
+
+  Statistics& statistics = self->statistics_;
+  ++statistics.gc_count;
+  if (type == v8::kGCTypeMarkSweepCompact)
+    ++statistics.major_gc_count;
+  if (self->in_idle_task_)
+    ++statistics.idle_gc_count;
+  statistics.total_pause += pause;
+  statistics.max_pause = std::max(statistics.max_pause, pause);
+}
+
+}  // namespace atom
@@ -0,0 +1,109 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+#define ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+
+#include <vector>
+
+#include "atom/common/node_bindings.h"
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Gives V8 idle time for garbage collection while the thread its isolate
+// lives on has no work to do. The thread counts as idle once no task has run
+// for a short while and there was no recent user input. Once V8 reports that
+// it has nothing left to do the scheduler backs off until the thread has
+// been busy again for a while. Runs of the uv loop count as work too, when the
+// scheduler observes the thread's NodeBindings. There can be one scheduler per
+// thread, and it must be created and destroyed on the isolate's thread.
+class IdleGCScheduler : public base::MessageLoop::TaskObserver,
+                        public NodeBindings::UvRunObserver {
+ public:
+  struct Statistics {
+    Statistics();
+
+    int gc_count;
+    int major_gc_count;
+    // Collections that ran inside an idle slice.
+    int idle_gc_count;
+    base::TimeDelta total_pause;
+    base::TimeDelta max_pause;
+    int idle_notification_count;
+    base::TimeDelta idle_time;
+  };
+
+  explicit IdleGCScheduler(v8::Isolate* isolate);
+  ~IdleGCScheduler() override;
+
+  // Returns the scheduler of the current thread, or null.
+  static IdleGCScheduler* current();
+
+  // Postpones idle work while the user is interacting.
+  void NotifyUserActivity();
+
+  // Runs |task| once the thread is next idle, ahead of V8's idle work. The
+  // thread counts as busy again after the task.
+  void PostIdleTask(const base::Closure& task);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  // Runs each time V8 has finished its idle work.
+  void set_idle_work_done_callback(const base::Closure& callback) {
+    idle_work_done_callback_ = callback;
+  }
+
+  const Statistics& statistics() const { return statistics_; }
+
+ private:
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+  // NodeBindings::UvRunObserver:
+  void DidRunUvLoop() override;
+
+  // Marks the thread busy after it did some work.
+  void DidDoWork();
+
+  void ScheduleIdleTask(base::TimeDelta delay);
+  void OnIdle();
+
+  static void OnGCPrologue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags);
+  static void OnGCEpilogue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags);
+
+  v8::Isolate* isolate_;
+
+  base::TimeTicks last_busy_time_;
+  base::TimeTicks last_input_time_;
+  base::TimeTicks idle_work_done_time_;
+  base::TimeTicks gc_start_time_;
+  bool idle_work_done_;
+  bool idle_task_pending_;
+  bool in_idle_task_;
+
+  std::vector<base::Closure> idle_tasks_;
+  base::Closure idle_work_done_callback_;
+  Statistics statistics_;
+
+  base::WeakPtrFactory<IdleGCScheduler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleGCScheduler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
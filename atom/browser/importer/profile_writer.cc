@@ -29,6 +29,7 @@
 // #include "chrome/browser/search_engines/template_url_service_factory.h"
 // #include "chrome/browser/web_data_service_factory.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
+#include "chrome/common/importer/importer_data_types.h"
 #include "chrome/common/pref_names.h"
 #include "components/autofill/core/browser/webdata/autofill_entry.h"
 #include "components/autofill/core/common/password_form.h"
@@ -147,6 +148,7 @@ void ProfileWriter::AddHistoryPage(const history::URLRows& page,
     }
     importer_->Emit("add-history-page", history_list,
                     (unsigned int) visit_source);
+    importer_->OnItemsImported(importer::HISTORY, page.size());
   }
 }
 
@@ -502,6 +504,7 @@ void ProfileWriter::AddCookies(
       imported_cookies.Append(std::unique_ptr<base::DictionaryValue>(cookie));
     }
     importer_->Emit("add-cookies", imported_cookies);
+    importer_->OnItemsImported(importer::COOKIES, cookies.size());
   }
 }
 
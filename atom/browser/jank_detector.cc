@@ -0,0 +1,293 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/jank_detector.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/pending_task.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+const size_t kMaxLongTasks = 100;
+const int kMaxStackFrames = 10;
+
+base::LazyInstance<JankDetector>::Leaky g_jank_detector =
+    LAZY_INSTANCE_INITIALIZER;
+
+std::string ToStdString(v8::Local<v8::Value> value) {
+  if (value.IsEmpty())
+    return std::string();
+  v8::String::Utf8Value utf8(value);
+  return *utf8 ? std::string(*utf8, utf8.length()) : std::string();
+}
+
+}  // namespace
+
+JankDetector::LongTask::LongTask()
+    : line_number(-1),
+      nesting_depth(0) {
+}
+
+JankDetector::LongTask::LongTask(const LongTask& other) = default;
+
+JankDetector::LongTask::~LongTask() {
+}
+
+JankDetector::RunningTask::RunningTask() : id(0), is_uv_run(false) {
+}
+
+JankDetector::RunningTask::RunningTask(const RunningTask& other) = default;
+
+JankDetector::RunningTask::~RunningTask() {
+}
+
+// static
+JankDetector* JankDetector::GetInstance() {
+  return g_jank_detector.Pointer();
+}
+
+JankDetector::JankDetector()
+    : running_(false),
+      node_bindings_(nullptr),
+      next_task_id_(0),
+      isolate_(nullptr),
+      generation_(0),
+      current_task_id_(0),
+      interrupted_task_id_(0),
+      watchdog_wakeup_(&lock_),
+      watchdog_idle_(false) {
+}
+
+JankDetector::~JankDetector() {
+}
+
+void JankDetector::Start(v8::Isolate* isolate,
+                         NodeBindings* node_bindings,
+                         base::TimeDelta threshold,
+                         const LongTaskCallback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  callback_ = callback;
+
+  int generation;
+  {
+    base::AutoLock lock(lock_);
+    isolate_ = isolate;
+    threshold_ = threshold;
+    generation = ++generation_;
+    // The watchdog of the previous generation returns.
+    watchdog_wakeup_.Signal();
+  }
+
+  if (!watchdog_thread_) {
+    watchdog_thread_.reset(new base::Thread("JankWatchdog"));
+    watchdog_thread_->Start();
+  }
+  watchdog_thread_->task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(&JankDetector::WatchForLongTasks, base::Unretained(this),
+                 generation));
+
+  if (!running_) {
+    running_ = true;
+    base::MessageLoop::current()->AddTaskObserver(this);
+    node_bindings_ = node_bindings;
+    node_bindings_->AddUvRunObserver(this);
+  }
+}
+
+void JankDetector::Stop() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!running_)
+    return;
+
+  running_ = false;
+  base::MessageLoop::current()->RemoveTaskObserver(this);
+  node_bindings_->RemoveUvRunObserver(this);
+  node_bindings_ = nullptr;
+  running_tasks_.clear();
+  callback_.Reset();
+
+  // The watchdog thread is kept around, idle, since joining it would block
+  // the UI thread.
+  base::AutoLock lock(lock_);
+  ++generation_;
+  current_task_id_ = 0;
+  watchdog_wakeup_.Signal();
+}
+
+void JankDetector::WillProcessTask(const base::PendingTask& pending_task) {
+  BeginTask(pending_task.posted_from, false);
+}
+
+void JankDetector::DidProcessTask(const base::PendingTask& pending_task) {
+  EndTask();
+}
+
+void JankDetector::WillRunUvLoop() {
+  BeginTask(tracked_objects::Location("NodeBindings::UvRunOnce",
+                                      "atom/common/node_bindings.cc",
+                                      -1, nullptr),
+            true);
+}
+
+void JankDetector::DidRunUvLoop() {
+  // The detector may have been started by script run from this uv run.
+  if (running_tasks_.empty() || !running_tasks_.back().is_uv_run)
+    return;
+  EndTask();
+}
+
+void JankDetector::BeginTask(const tracked_objects::Location& posted_from,
+                             bool is_uv_run) {
+  RunningTask task;
+  task.id = ++next_task_id_;
+  task.start_ticks = base::TimeTicks::Now();
+  task.posted_from = posted_from;
+  task.is_uv_run = is_uv_run;
+  running_tasks_.push_back(task);
+  // A task that starts inside the watched one is due after it, so the
+  // watchdog only has to be woken if it isn't watching any.
+  UpdateCurrentTask(false);
+}
+
+void JankDetector::EndTask() {
+  // The detector may have been started from inside a task.
+  if (running_tasks_.empty())
+    return;
+
+  RunningTask task = running_tasks_.back();
+  running_tasks_.pop_back();
+  // The outer task, if any, is due before the one that ended.
+  UpdateCurrentTask(!running_tasks_.empty());
+
+  base::TimeDelta duration = base::TimeTicks::Now() - task.start_ticks;
+  if (task.is_uv_run && !running_tasks_.empty())
+    running_tasks_.back().uv_run_time += duration;
+
+  base::TimeDelta threshold;
+  int generation;
+  {
+    base::AutoLock lock(lock_);
+    threshold = threshold_;
+    generation = generation_;
+  }
+  // A task that is only slow because of the uv run inside it, which was
+  // already reported, isn't reported again.
+  if (duration - task.uv_run_time < threshold)
+    return;
+
+  LongTask long_task;
+  // Wall clock time is only read for the few tasks that are reported.
+  long_task.start_time = base::Time::Now() - duration;
+  long_task.duration = duration;
+  long_task.function_name = task.posted_from.function_name();
+  long_task.file_name = task.posted_from.file_name();
+  long_task.line_number = task.posted_from.line_number();
+  // uv runs don't count as nesting, and neither does the task running a uv
+  // run.
+  int nesting_depth = static_cast<int>(std::count_if(
+      running_tasks_.begin(), running_tasks_.end(),
+      [](const RunningTask& running_task) { return !running_task.is_uv_run; }));
+  if (task.is_uv_run)
+    nesting_depth = std::max(nesting_depth - 1, 0);
+  long_task.nesting_depth = nesting_depth;
+  long_task.js_stack = task.js_stack;
+
+  long_tasks_.push_back(long_task);
+  if (long_tasks_.size() > kMaxLongTasks)
+    long_tasks_.pop_front();
+
+  // Script can't run from inside a task observer.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::Bind(&JankDetector::NotifyLongTask, base::Unretained(this),
+                 generation, long_task));
+}
+
+void JankDetector::UpdateCurrentTask(bool wake_watchdog) {
+  base::AutoLock lock(lock_);
+  if (running_tasks_.empty()) {
+    current_task_id_ = 0;
+    return;
+  }
+  current_task_id_ = running_tasks_.back().id;
+  current_task_start_ = running_tasks_.back().start_ticks;
+  if (wake_watchdog || watchdog_idle_)
+    watchdog_wakeup_.Signal();
+}
+
+void JankDetector::WatchForLongTasks(int generation) {
+  base::AutoLock lock(lock_);
+  while (generation == generation_) {
+    // Each task is interrupted at most once.
+    if (!current_task_id_ || current_task_id_ == interrupted_task_id_) {
+      watchdog_idle_ = true;
+      watchdog_wakeup_.Wait();
+      watchdog_idle_ = false;
+      continue;
+    }
+
+    base::TimeDelta remaining =
+        current_task_start_ + threshold_ - base::TimeTicks::Now();
+    if (remaining > base::TimeDelta()) {
+      watchdog_wakeup_.TimedWait(remaining);
+      continue;
+    }
+
+    interrupted_task_id_ = current_task_id_;
+    isolate_->RequestInterrupt(&JankDetector::OnInterrupt, this);
+  }
+}
+
+// static
+void JankDetector::OnInterrupt(v8::Isolate* isolate, void* data) {
+  static_cast<JankDetector*>(data)->CaptureJsStack(isolate);
+}
+
+void JankDetector::CaptureJsStack(v8::Isolate* isolate) {
+  // Script may run again only after the task the interrupt was requested for
+  // has finished.
+  if (running_tasks_.empty())
+    return;
+  RunningTask& task = running_tasks_.back();
+  {
+    base::AutoLock lock(lock_);
+    if (task.id != interrupted_task_id_)
+      return;
+  }
+
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack_trace = v8::StackTrace::CurrentStackTrace(
+      isolate, kMaxStackFrames, v8::StackTrace::kDetailed);
+  for (int i = 0; i < stack_trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = stack_trace->GetFrame(i);
+    std::string function_name = ToStdString(frame->GetFunctionName());
+    task.js_stack.push_back(base::StringPrintf("%s (%s:%d:%d)",
+        function_name.empty() ? "<anonymous>" : function_name.c_str(),
+        ToStdString(frame->GetScriptName()).c_str(),
+        frame->GetLineNumber(), frame->GetColumn()));
+  }
+}
+
+void JankDetector::NotifyLongTask(int generation, const LongTask& long_task) {
+  {
+    base::AutoLock lock(lock_);
+    if (generation != generation_)
+      return;
+  }
+  if (!callback_.is_null())
+    callback_.Run(long_task);
+}
+
+}  // namespace atom
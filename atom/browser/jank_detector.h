@@ -0,0 +1,151 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_JANK_DETECTOR_H_
+#define ATOM_BROWSER_JANK_DETECTOR_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "atom/common/node_bindings.h"
+#include "base/callback.h"
+#include "base/lazy_instance.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace base {
+class Thread;
+}
+
+namespace atom {
+
+// Watches the UI thread for tasks that run longer than a threshold. Tasks are
+// attributed to the location they were posted from. A watchdog thread
+// notices tasks that are still running past the threshold and interrupts V8
+// to capture the JavaScript stack, which attributes tasks that run script to
+// the handler that was running. Runs of the uv loop, which node's timer and io
+// callbacks run in, are timed on their own whether or not a task runs them.
+// The most recent long tasks are kept in a ring buffer. The cost while
+// running is two clock reads and two uncontended lock acquisitions per task.
+// The watchdog sleeps while the UI thread is idle and only wakes up when a
+// task starts, or when the task it watches reaches the threshold.
+class JankDetector : public base::MessageLoop::TaskObserver,
+                     public NodeBindings::UvRunObserver {
+ public:
+  struct LongTask {
+    LongTask();
+    LongTask(const LongTask& other);
+    ~LongTask();
+
+    base::Time start_time;
+    base::TimeDelta duration;
+    std::string function_name;
+    std::string file_name;
+    int line_number;
+    // Greater than 0 for tasks run by a nested message loop.
+    int nesting_depth;
+    // Empty unless the task was still running script when the watchdog
+    // checked on it.
+    std::vector<std::string> js_stack;
+  };
+  using LongTaskCallback = base::Callback<void(const LongTask&)>;
+
+  static JankDetector* GetInstance();
+
+  // Starts watching the current thread, which must be the UI thread, and
+  // runs |callback| after each task that took longer than |threshold|.
+  // |node_bindings| runs the thread's uv loop.
+  void Start(v8::Isolate* isolate,
+             NodeBindings* node_bindings,
+             base::TimeDelta threshold,
+             const LongTaskCallback& callback);
+  void Stop();
+  bool IsRunning() const { return running_; }
+
+  // Oldest first.
+  const std::deque<LongTask>& long_tasks() const { return long_tasks_; }
+
+ private:
+  friend struct base::DefaultLazyInstanceTraits<JankDetector>;
+
+  struct RunningTask {
+    RunningTask();
+    RunningTask(const RunningTask& other);
+    ~RunningTask();
+
+    int64_t id;
+    base::TimeTicks start_ticks;
+    tracked_objects::Location posted_from;
+    // Time spent in uv loop runs inside the task, which are reported on
+    // their own.
+    base::TimeDelta uv_run_time;
+    bool is_uv_run;
+    std::vector<std::string> js_stack;
+  };
+
+  JankDetector();
+  ~JankDetector() override;
+
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+  // NodeBindings::UvRunObserver:
+  void WillRunUvLoop() override;
+  void DidRunUvLoop() override;
+
+  void BeginTask(const tracked_objects::Location& posted_from, bool is_uv_run);
+  void EndTask();
+
+  // Publishes the innermost running task to the watchdog. |wake_watchdog|
+  // wakes it even if it is waiting for the deadline of another task.
+  void UpdateCurrentTask(bool wake_watchdog);
+
+  // Runs on the watchdog thread until |generation| is stopped.
+  void WatchForLongTasks(int generation);
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data);
+  void CaptureJsStack(v8::Isolate* isolate);
+
+  void NotifyLongTask(int generation, const LongTask& long_task);
+
+  // Only used on the UI thread.
+  bool running_;
+  NodeBindings* node_bindings_;
+  std::vector<RunningTask> running_tasks_;
+  std::deque<LongTask> long_tasks_;
+  LongTaskCallback callback_;
+  int64_t next_task_id_;
+
+  std::unique_ptr<base::Thread> watchdog_thread_;
+
+  // Shared with the watchdog thread.
+  base::Lock lock_;
+  v8::Isolate* isolate_;
+  base::TimeDelta threshold_;
+  int generation_;
+  int64_t current_task_id_;
+  base::TimeTicks current_task_start_;
+  int64_t interrupted_task_id_;
+  // Signaled when the watchdog has to look at the current task again.
+  base::ConditionVariable watchdog_wakeup_;
+  // Whether the watchdog is waiting for a task to start, rather than for the
+  // current task to reach the threshold.
+  bool watchdog_idle_;
+
+  DISALLOW_COPY_AND_ASSIGN(JankDetector);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_JANK_DETECTOR_H_
@@ -17,6 +17,8 @@
 #include "atom/common/api/api_messages.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
+#include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/json/json_writer.h"
 #include "base/message_loop/message_loop.h"
@@ -25,6 +27,7 @@
 #include "brightray/browser/inspectable_web_contents_view.h"
 #include "components/prefs/pref_service.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/plugin_service.h"
 #include "content/public/browser/render_process_host.h"
@@ -52,6 +55,38 @@ DEFINE_WEB_CONTENTS_USER_DATA_KEY(atom::NativeWindowRelay);
 
 namespace atom {
 
+namespace {
+
+void WriteStartupTimeline(const base::FilePath& path,
+                          const std::string& json) {
+  if (base::WriteFile(path, json.data(), json.size()) !=
+      static_cast<int>(json.size()))
+    LOG(ERROR) << "Failed to write the startup timeline to " << path.value();
+}
+
+// Ends the startup timeline at the first paint of the first window, and
+// writes it out if --startup-timeline was given.
+void RecordFirstWindowPaint() {
+  auto startup_timeline = StartupTimeline::GetInstance();
+  if (startup_timeline->IsFinished())
+    return;
+  startup_timeline->Finish("FirstWindowPaint");
+
+  base::FilePath path = base::CommandLine::ForCurrentProcess()->
+      GetSwitchValuePath(switches::kStartupTimeline);
+  if (path.empty())
+    return;
+
+  std::string json;
+  base::JSONWriter::WriteWithOptions(*startup_timeline->ToValue(),
+                                     base::JSONWriter::OPTIONS_PRETTY_PRINT,
+                                     &json);
+  content::BrowserThread::PostBlockingPoolTask(
+      FROM_HERE, base::Bind(&WriteStartupTimeline, path, json));
+}
+
+}  // namespace
+
 NativeWindow::NativeWindow(
     brightray::InspectableWebContents* inspectable_web_contents,
     const mate::Dictionary& options,
@@ -573,6 +608,8 @@ void NativeWindow::BeforeUnloadDialogCancelled() {
 }
 
 void NativeWindow::DidFirstVisuallyNonEmptyPaint() {
+  RecordFirstWindowPaint();
+
   if (IsVisible())
     return;
 
@@ -8,8 +8,10 @@
 #include <utility>
 
 #include "atom/common/native_mate_converters/net_converter.h"
+#include "base/macros.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
+#include "base/supports_user_data.h"
 #include "chrome/browser/devtools/devtools_network_transaction.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/websocket_handshake_request_info.h"
@@ -85,48 +87,91 @@ bool MatchesFilterCondition(net::URLRequest* request,
   return false;
 }
 
-int GetTabId(net::URLRequest* request) {
+// Returns true when the tab of |request| could be looked up, which may not be
+// the case yet for requests that start before their frame is known.
+bool ResolveTabId(net::URLRequest* request, int* tab_id) {
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   int render_frame_id = -1;
   int render_process_id = -1;
-  int tab_id = -1;
   extensions::ExtensionApiFrameIdMap::FrameData frame_data;
-  if (content::ResourceRequestInfo::GetRenderFrameForRequest(
+  if (!content::ResourceRequestInfo::GetRenderFrameForRequest(
           request, &render_process_id, &render_frame_id)) {
-    if (extensions::ExtensionApiFrameIdMap::Get()->GetCachedFrameDataOnIO(
-            render_process_id, render_frame_id, &frame_data)) {
-      tab_id = frame_data.tab_id;
-    }
-  } else {
     const content::WebSocketHandshakeRequestInfo* websocket_info =
       content::WebSocketHandshakeRequestInfo::ForRequest(request);
-    if (websocket_info) {
-      render_frame_id = websocket_info->GetRenderFrameId();
-      render_process_id = websocket_info->GetChildId();
-      if (extensions::ExtensionApiFrameIdMap::Get()->GetCachedFrameDataOnIO(
-              render_process_id, render_frame_id, &frame_data)) {
-        tab_id = frame_data.tab_id;
-      }
-    }
+    if (!websocket_info)
+      return false;
+    render_frame_id = websocket_info->GetRenderFrameId();
+    render_process_id = websocket_info->GetChildId();
   }
-  return tab_id;
+  if (!extensions::ExtensionApiFrameIdMap::Get()->GetCachedFrameDataOnIO(
+          render_process_id, render_frame_id, &frame_data))
+    return false;
+  *tab_id = frame_data.tab_id;
+  return true;
 #else
-  return -1;
+  return false;
 #endif
 }
 
+// Details of a request that stay the same for all of its webRequest events.
+// They are computed on the first event and attached to the net::URLRequest so
+// later events don't have to look them up again.
+class RequestDetailsData : public base::SupportsUserData::Data {
+ public:
+  static RequestDetailsData* Get(net::URLRequest* request) {
+    RequestDetailsData* data = static_cast<RequestDetailsData*>(
+        request->GetUserData(kUserDataKey));
+    if (!data) {
+      data = new RequestDetailsData(request);
+      request->SetUserData(kUserDataKey, data);
+    }
+    return data;
+  }
+
+  int GetTabId(net::URLRequest* request) {
+    // A failed lookup is not cached since the frame data may only become
+    // available after the request has started.
+    if (!tab_id_resolved_)
+      tab_id_resolved_ = ResolveTabId(request, &tab_id_);
+    return tab_id_;
+  }
+
+  const char* resource_type() const { return resource_type_; }
+
+ private:
+  explicit RequestDetailsData(net::URLRequest* request)
+      : resource_type_("other"),
+        tab_id_(-1),
+        tab_id_resolved_(false) {
+    auto info = content::ResourceRequestInfo::ForRequest(request);
+    if (info)
+      resource_type_ = ResourceTypeToString(info->GetResourceType());
+  }
+
+  static const void* const kUserDataKey;
+
+  const char* resource_type_;
+  int tab_id_;
+  bool tab_id_resolved_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestDetailsData);
+};
+
+const void* const RequestDetailsData::kUserDataKey =
+    &RequestDetailsData::kUserDataKey;
+
 // Overloaded by multiple types to fill the |details| object.
 void ToDictionary(base::DictionaryValue* details, net::URLRequest* request) {
   FillRequestDetails(details, request);
   details->SetInteger("id", request->identifier());
   details->SetDouble("timestamp", base::Time::Now().ToDoubleT() * 1000);
+  // The first party URL is read every time as it follows main frame
+  // redirects.
   details->SetString("firstPartyUrl",
     request->first_party_for_cookies().spec());
-  auto info = content::ResourceRequestInfo::ForRequest(request);
-  details->SetString("resourceType",
-                     info ? ResourceTypeToString(info->GetResourceType())
-                          : "other");
-  details->SetInteger("tabId", GetTabId(request));
+  RequestDetailsData* data = RequestDetailsData::Get(request);
+  details->SetString("resourceType", data->resource_type());
+  details->SetInteger("tabId", data->GetTabId(request));
 }
 
 void ToDictionary(base::DictionaryValue* details,
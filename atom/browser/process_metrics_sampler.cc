@@ -0,0 +1,284 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/process_metrics_sampler.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "atom/browser/api/trackable_object.h"
+#include "base/bind.h"
+#include "base/process/process.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "content/public/browser/browser_child_process_host.h"
+#include "content/public/browser/browser_child_process_host_iterator.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/child_process_data.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/common/process_type.h"
+#include "extensions/features/features.h"
+
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+#include "atom/browser/extensions/tab_helper.h"
+#endif
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+// A process found by the UI or IO thread that hasn't been measured yet.
+struct PendingProcess {
+  PendingProcess(const std::string& type, base::Process process)
+      : process(std::move(process)) {
+    info.type = type;
+  }
+  PendingProcess(PendingProcess&& other) = default;
+  PendingProcess& operator=(PendingProcess&& other) = default;
+
+  ProcessMetricsSampler::ProcessInfo info;
+  base::Process process;
+};
+
+using PendingProcessList = std::vector<PendingProcess>;
+
+// The handles are duplicated so that they stay valid on the sampling
+// sequence even if the process host goes away.
+base::Process DuplicateProcess(base::ProcessHandle handle) {
+  return base::Process::DeprecatedGetProcessFromHandle(handle).Duplicate();
+}
+
+std::unique_ptr<base::ProcessMetrics> CreateProcessMetrics(
+    const base::Process& process) {
+  if (process.Pid() == base::GetCurrentProcId()) {
+    return std::unique_ptr<base::ProcessMetrics>(
+        base::ProcessMetrics::CreateCurrentProcessMetrics());
+  }
+#if defined(OS_MACOSX)
+  return std::unique_ptr<base::ProcessMetrics>(
+      base::ProcessMetrics::CreateProcessMetrics(
+          process.Handle(),
+          content::BrowserChildProcessHost::GetPortProvider()));
+#else
+  return std::unique_ptr<base::ProcessMetrics>(
+      base::ProcessMetrics::CreateProcessMetrics(process.Handle()));
+#endif
+}
+
+template<typename T>
+void AddUnique(std::vector<T>* values, T value) {
+  if (std::find(values->begin(), values->end(), value) == values->end())
+    values->push_back(value);
+}
+
+void AddWebContents(PendingProcess* pending,
+                    content::WebContents* web_contents) {
+  int32_t id = mate::TrackableObjectBase::GetIDFromWrappedClass(web_contents);
+  if (id)
+    AddUnique(&pending->info.web_contents_ids, id);
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  int32_t tab_id = extensions::TabHelper::IdForTab(web_contents);
+  if (tab_id != -1)
+    AddUnique(&pending->info.tab_ids, tab_id);
+#endif
+}
+
+// Lists the browser process and the renderers along with the WebContents
+// they host.
+std::unique_ptr<PendingProcessList> ListBrowserAndRenderers() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  std::unique_ptr<PendingProcessList> processes(new PendingProcessList);
+  processes->push_back(PendingProcess("Browser", base::Process::Current()));
+
+  std::map<int, size_t> renderers;
+  for (auto it = content::RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (!host->HasConnection() ||
+        host->GetHandle() == base::kNullProcessHandle)
+      continue;
+    renderers[host->GetID()] = processes->size();
+    processes->push_back(
+        PendingProcess("Renderer", DuplicateProcess(host->GetHandle())));
+  }
+
+  std::unique_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    auto renderer = renderers.find(widget->GetProcess()->GetID());
+    if (renderer == renderers.end())
+      continue;
+    content::RenderViewHost* view = content::RenderViewHost::From(widget);
+    content::WebContents* web_contents =
+        view ? content::WebContents::FromRenderViewHost(view) : nullptr;
+    if (web_contents)
+      AddWebContents(&(*processes)[renderer->second], web_contents);
+  }
+
+  return processes;
+}
+
+void IgnoreSample(const ProcessMetricsSampler::ProcessInfoList& processes) {
+}
+
+}  // namespace
+
+class ProcessMetricsSampler::Core
+    : public base::RefCountedThreadSafe<ProcessMetricsSampler::Core> {
+ public:
+  Core() {
+    base::SequencedWorkerPool* pool = BrowserThread::GetBlockingPool();
+    task_runner_ = pool->GetSequencedTaskRunner(pool->GetSequenceToken());
+  }
+
+  void Sample(const SampleCallback& callback) {
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+        base::Bind(&Core::ListChildProcesses, this,
+                   base::Passed(ListBrowserAndRenderers()), callback));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Core>;
+
+  struct Entry {
+    base::Process process;
+    std::unique_ptr<base::ProcessMetrics> metrics;
+  };
+
+  ~Core() {}
+
+  void ListChildProcesses(std::unique_ptr<PendingProcessList> processes,
+                          const SampleCallback& callback) {
+    DCHECK_CURRENTLY_ON(BrowserThread::IO);
+    for (content::BrowserChildProcessHostIterator it; !it.Done(); ++it) {
+      const content::ChildProcessData& data = it.GetData();
+      if (data.handle == base::kNullProcessHandle)
+        continue;
+      processes->push_back(PendingProcess(
+          content::GetProcessTypeNameInEnglish(data.process_type),
+          DuplicateProcess(data.handle)));
+    }
+
+    task_runner_->PostTask(FROM_HERE,
+        base::Bind(&Core::Measure, this, base::Passed(&processes), callback));
+  }
+
+  void Measure(std::unique_ptr<PendingProcessList> processes,
+               const SampleCallback& callback) {
+    DCHECK(task_runner_->RunsTasksOnCurrentThread());
+    std::unique_ptr<ProcessInfoList> results(new ProcessInfoList);
+
+    // Processes that are gone are dropped by only keeping the entries that
+    // were seen in this sample.
+    std::map<base::ProcessId, Entry> previous_entries;
+    previous_entries.swap(entries_);
+
+    for (PendingProcess& pending : *processes) {
+      if (!pending.process.IsValid())
+        continue;
+      base::ProcessId pid = pending.process.Pid();
+      if (entries_.count(pid))
+        continue;
+
+      Entry entry;
+      auto previous = previous_entries.find(pid);
+      if (previous != previous_entries.end()) {
+        entry = std::move(previous->second);
+      } else {
+        entry.process = std::move(pending.process);
+        entry.metrics = CreateProcessMetrics(entry.process);
+      }
+
+      ProcessInfo& info = pending.info;
+      info.pid = pid;
+      info.cpu_usage = entry.metrics->GetPlatformIndependentCPUUsage();
+      info.working_set_size = entry.metrics->GetWorkingSetSize();
+      size_t shared_bytes;
+      if (!entry.metrics->GetMemoryBytes(&info.private_bytes, &shared_bytes))
+        info.private_bytes = 0;
+      info.has_io_counters = entry.metrics->GetIOCounters(&info.io_counters);
+      results->push_back(info);
+
+      entries_[pid] = std::move(entry);
+    }
+
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+        base::Bind(&Core::RunCallback, callback, base::Passed(&results)));
+  }
+
+  static void RunCallback(const SampleCallback& callback,
+                          std::unique_ptr<ProcessInfoList> results) {
+    callback.Run(*results);
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Only used on |task_runner_|.
+  std::map<base::ProcessId, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+ProcessMetricsSampler::ProcessInfo::ProcessInfo()
+    : pid(base::kNullProcessId),
+      cpu_usage(0),
+      working_set_size(0),
+      private_bytes(0),
+      has_io_counters(false),
+      io_counters() {
+}
+
+ProcessMetricsSampler::ProcessInfo::ProcessInfo(const ProcessInfo& other) =
+    default;
+
+ProcessMetricsSampler::ProcessInfo::~ProcessInfo() {
+}
+
+ProcessMetricsSampler::ProcessMetricsSampler()
+    : core_(new Core),
+      weak_factory_(this) {
+}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() {
+}
+
+void ProcessMetricsSampler::Sample(const SampleCallback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  core_->Sample(callback);
+}
+
+void ProcessMetricsSampler::Start(base::TimeDelta interval,
+                                  const SampleCallback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  periodic_callback_ = callback;
+  timer_.Start(FROM_HERE, interval,
+               base::Bind(&ProcessMetricsSampler::OnTimer,
+                          base::Unretained(this)));
+  // Takes the baseline the first CPU usage figures are measured against.
+  Sample(base::Bind(&IgnoreSample));
+}
+
+void ProcessMetricsSampler::Stop() {
+  timer_.Stop();
+  periodic_callback_.Reset();
+}
+
+void ProcessMetricsSampler::OnTimer() {
+  Sample(base::Bind(&ProcessMetricsSampler::OnPeriodicSample,
+                    weak_factory_.GetWeakPtr()));
+}
+
+void ProcessMetricsSampler::OnPeriodicSample(
+    const ProcessInfoList& processes) {
+  if (!periodic_callback_.is_null())
+    periodic_callback_.Run(processes);
+}
+
+}  // namespace atom
@@ -0,0 +1,78 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
+#define ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/process/process_metrics.h"
+#include "base/timer/timer.h"
+
+namespace atom {
+
+// Measures the resource usage of the browser process and of every child
+// process: renderers, GPU, utility and plugin processes. Worker threads run
+// inside the browser process and are counted there. Processes are listed on
+// the UI and IO threads, and measured on a blocking pool sequence which keeps
+// the per-process state needed to compute CPU usage between samples.
+class ProcessMetricsSampler {
+ public:
+  struct ProcessInfo {
+    ProcessInfo();
+    ProcessInfo(const ProcessInfo& other);
+    ~ProcessInfo();
+
+    base::ProcessId pid;
+    std::string type;
+    // The WebContents and tabs hosted by a renderer process.
+    std::vector<int32_t> web_contents_ids;
+    std::vector<int32_t> tab_ids;
+    // Percentage of one CPU used since the previous sample, 0 the first time
+    // a process is sampled.
+    double cpu_usage;
+    size_t working_set_size;
+    size_t private_bytes;
+    bool has_io_counters;
+    base::IoCounters io_counters;
+  };
+  using ProcessInfoList = std::vector<ProcessInfo>;
+  using SampleCallback = base::Callback<void(const ProcessInfoList&)>;
+
+  ProcessMetricsSampler();
+  ~ProcessMetricsSampler();
+
+  // Runs |callback| on the UI thread with the metrics of every process.
+  void Sample(const SampleCallback& callback);
+
+  // Samples every |interval| until Stop() is called.
+  void Start(base::TimeDelta interval, const SampleCallback& callback);
+  void Stop();
+  bool IsRunning() const { return timer_.IsRunning(); }
+
+ private:
+  class Core;
+
+  void OnTimer();
+  void OnPeriodicSample(const ProcessInfoList& processes);
+
+  scoped_refptr<Core> core_;
+  base::RepeatingTimer timer_;
+  SampleCallback periodic_callback_;
+
+  base::WeakPtrFactory<ProcessMetricsSampler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_PROCESS_METRICS_SAMPLER_H_
@@ -29,6 +29,13 @@ IPC_MESSAGE_ROUTED3(AtomViewMsg_Message,
                     base::string16 /* channel */,
                     base::ListValue /* arguments */)
 
+// Messages of batched channels, see atom::IPCMessageBatch.
+IPC_MESSAGE_ROUTED1(AtomViewHostMsg_MessageBatch,
+                    base::ListValue /* batch */)
+
+IPC_MESSAGE_ROUTED1(AtomViewMsg_MessageBatch,
+                    base::ListValue /* batch */)
+
 // Update renderer process preferences.
 IPC_MESSAGE_CONTROL1(AtomMsg_UpdatePreferences, base::ListValue)
 
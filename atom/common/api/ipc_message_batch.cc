@@ -0,0 +1,58 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/ipc_message_batch.h"
+
+#include <utility>
+
+namespace atom {
+
+IPCMessageBatch::IPCMessageBatch() : batch_(new base::ListValue) {
+}
+
+IPCMessageBatch::~IPCMessageBatch() {
+}
+
+bool IPCMessageBatch::Add(const base::string16& channel,
+                          const base::ListValue& args,
+                          bool coalesce,
+                          base::TimeTicks deadline) {
+  // Batches only hold a handful of channels, so a linear search is fine.
+  base::ListValue* messages = nullptr;
+  size_t index = 0;
+  for (; index < batch_->GetSize(); ++index) {
+    base::ListValue* entry;
+    base::string16 entry_channel;
+    if (batch_->GetList(index, &entry) && entry->GetString(0, &entry_channel) &&
+        entry_channel == channel) {
+      messages = entry;
+      break;
+    }
+  }
+
+  if (!messages || coalesce) {
+    std::unique_ptr<base::ListValue> entry(new base::ListValue);
+    entry->AppendString(channel);
+    messages = entry.get();
+    if (index < batch_->GetSize())
+      batch_->Set(index, std::move(entry));
+    else
+      batch_->Append(std::move(entry));
+  }
+  messages->Append(args.CreateDeepCopy());
+
+  if (!deadline_.is_null() && deadline_ <= deadline)
+    return false;
+  deadline_ = deadline;
+  return true;
+}
+
+std::unique_ptr<base::ListValue> IPCMessageBatch::Take() {
+  std::unique_ptr<base::ListValue> batch(new base::ListValue);
+  batch.swap(batch_);
+  deadline_ = base::TimeTicks();
+  return batch;
+}
+
+}  // namespace atom
@@ -0,0 +1,51 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_IPC_MESSAGE_BATCH_H_
+#define ATOM_COMMON_API_IPC_MESSAGE_BATCH_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace atom {
+
+// Collects IPC messages so that they can be sent, and dispatched to JS, as a
+// single message. Messages are grouped by channel, in the order each channel
+// was first used, and keep their order within a channel. The batch is due
+// when the earliest deadline of its messages is reached.
+class IPCMessageBatch {
+ public:
+  IPCMessageBatch();
+  ~IPCMessageBatch();
+
+  // Adds a message with |args| to |channel| that has to be sent by
+  // |deadline|. With |coalesce|, the message replaces the ones already queued
+  // for |channel|. Returns true if the batch is now due earlier than before.
+  bool Add(const base::string16& channel,
+           const base::ListValue& args,
+           bool coalesce,
+           base::TimeTicks deadline);
+
+  bool empty() const { return batch_->empty(); }
+  base::TimeTicks deadline() const { return deadline_; }
+
+  // Returns the batch as a list with an entry per channel, each holding the
+  // channel followed by the argument lists of its messages, and starts a new
+  // batch.
+  std::unique_ptr<base::ListValue> Take();
+
+ private:
+  std::unique_ptr<base::ListValue> batch_;
+  base::TimeTicks deadline_;
+
+  DISALLOW_COPY_AND_ASSIGN(IPCMessageBatch);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_IPC_MESSAGE_BATCH_H_
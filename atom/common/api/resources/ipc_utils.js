@@ -6,9 +6,24 @@ var ipcRenderer = atom.v8.getHiddenValue('ipc')
 if (!ipcRenderer) {
   ipcRenderer = new EventEmitter
 
+  var batchedChannels = { __proto__: null }
+
+  ipcRenderer.setBatching = function (channel, options) {
+    if (options) {
+      batchedChannels[channel] = options
+    } else {
+      delete batchedChannels[channel]
+    }
+  }
+
   ipcRenderer.send = function () {
     var args
     args = 1 <= arguments.length ? $Array.slice(arguments, 0) : []
+    var batching = batchedChannels[args[0]]
+    if (batching) {
+      return ipc.sendBatched(args[0], $Array.slice(args, 1),
+                             !!batching.coalesce, batching.interval || 0)
+    }
     return ipc.send('ipc-message', $Array.slice(args))
   }
 
@@ -50,6 +65,7 @@ exports.$set('removeAllListeners', ipcRenderer.removeAllListeners.bind(ipcRender
 exports.$set('on', ipcRenderer.on.bind(ipcRenderer))
 exports.$set('once', ipcRenderer.once.bind(ipcRenderer))
 exports.$set('send', ipcRenderer.send.bind(ipcRenderer))
+exports.$set('setBatching', ipcRenderer.setBatching.bind(ipcRenderer))
 exports.$set('sendSync', ipcRenderer.sendSync.bind(ipcRenderer))
 exports.$set('sendToHost', ipcRenderer.sendToHost.bind(ipcRenderer))
 exports.$set('emit', ipcRenderer.emit.bind(ipcRenderer))
@@ -4,7 +4,9 @@
 
 #include "atom/common/javascript_bindings.h"
 
+#include <algorithm>
 #include <vector>
+
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/atom_api_key_weak_map.h"
 #include "atom/common/api/remote_callback_freer.h"
@@ -12,6 +14,7 @@
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/strings/utf_string_conversions.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
 #include "extensions/renderer/console.h"
@@ -135,6 +138,32 @@ void JavascriptBindings::IPCSend(mate::Arguments* args,
     args->ThrowError("Unable to send AtomViewHostMsg_Message");
 }
 
+void JavascriptBindings::IPCSendBatched(const base::string16& channel,
+                                        const base::ListValue& arguments,
+                                        bool coalesce,
+                                        int interval_ms) {
+  if (!is_valid() || !render_view())
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (ipc_batch_.Add(channel, arguments, coalesce,
+                     now + base::TimeDelta::FromMilliseconds(
+                         std::max(interval_ms, 0)))) {
+    // The batch goes out when the channel with the shortest interval is due.
+    ipc_batch_timer_.Start(FROM_HERE, ipc_batch_.deadline() - now,
+                           base::Bind(&JavascriptBindings::FlushIPCBatch,
+                                      base::Unretained(this)));
+  }
+}
+
+void JavascriptBindings::FlushIPCBatch() {
+  if (!is_valid() || !render_view() || ipc_batch_.empty())
+    return;
+
+  render_view()->Send(new AtomViewHostMsg_MessageBatch(
+      render_view()->GetRoutingID(), *ipc_batch_.Take()));
+}
+
 base::string16 JavascriptBindings::IPCSendSync(mate::Arguments* args,
                         const base::string16& channel,
                         const base::ListValue& arguments) {
@@ -167,6 +196,8 @@ void JavascriptBindings::GetBinding(
       base::Unretained(this)));
   ipc.SetMethod("sendSync", base::Bind(&JavascriptBindings::IPCSendSync,
       base::Unretained(this)));
+  ipc.SetMethod("sendBatched", base::Bind(&JavascriptBindings::IPCSendBatched,
+      base::Unretained(this)));
   binding.Set("ipc", ipc.GetHandle());
 
   mate::Dictionary v8(isolate, v8::Object::New(isolate));
@@ -205,6 +236,7 @@ bool JavascriptBindings::OnMessageReceived(const IPC::Message& message) {
   bool handled = false;  // don't swallow any of these messages
   IPC_BEGIN_MESSAGE_MAP(JavascriptBindings, message)
     IPC_MESSAGE_HANDLER(AtomViewMsg_Message, OnBrowserMessage)
+    IPC_MESSAGE_HANDLER(AtomViewMsg_MessageBatch, OnBrowserMessageBatch)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -239,4 +271,41 @@ void JavascriptBindings::OnBrowserMessage(bool all_frames,
                                   &concatenated_args.front());
 }
 
+void JavascriptBindings::OnBrowserMessageBatch(const base::ListValue& batch) {
+  if (!is_valid())
+    return;
+
+  v8::Isolate* isolate = context()->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(context()->v8_context());
+
+  // Each channel gets a single event with the argument lists of all of its
+  // messages. It is emitted as "<channel>:batch", so the listeners of the
+  // channel itself always get the arguments of a single message.
+  for (size_t i = 0; i < batch.GetSize(); ++i) {
+    const base::ListValue* entry;
+    base::string16 channel;
+    if (!batch.GetList(i, &entry) || !entry->GetString(0, &channel))
+      continue;
+
+    std::vector<v8::Local<v8::Value>> messages;
+    for (size_t j = 1; j < entry->GetSize(); ++j) {
+      const base::ListValue* message;
+      if (entry->GetList(j, &message))
+        messages.push_back(mate::ConvertToV8(isolate, *message));
+    }
+
+    mate::Dictionary event = mate::Dictionary::CreateEmpty(isolate);
+    std::vector<v8::Local<v8::Value>> emit_args = {
+      mate::StringToV8(isolate, channel + base::ASCIIToUTF16(":batch")),
+      event.GetHandle(),
+      mate::ConvertToV8(isolate, messages),
+    };
+    context()->module_system()->CallModuleMethod("ipc_utils",
+                                                 "emit",
+                                                 emit_args.size(),
+                                                 &emit_args.front());
+  }
+}
+
 }  // namespace atom
@@ -5,6 +5,8 @@
 #ifndef ATOM_COMMON_JAVASCRIPT_BINDINGS_H_
 #define ATOM_COMMON_JAVASCRIPT_BINDINGS_H_
 
+#include "atom/common/api/ipc_message_batch.h"
+#include "base/timer/timer.h"
 #include "content/public/renderer/render_view_observer.h"
 #include "extensions/renderer/object_backed_native_handler.h"
 #include "extensions/renderer/script_context.h"
@@ -32,6 +34,11 @@ class JavascriptBindings : public content::RenderViewObserver,
   void IPCSend(mate::Arguments* args,
                         const base::string16& channel,
                         const base::ListValue& arguments);
+  void IPCSendBatched(const base::string16& channel,
+                      const base::ListValue& arguments,
+                      bool coalesce,
+                      int interval_ms);
+  void FlushIPCBatch();
   v8::Local<v8::Value> GetHiddenValue(v8::Isolate* isolate,
                                     v8::Local<v8::String> key);
   void SetHiddenValue(v8::Isolate* isolate,
@@ -59,6 +66,11 @@ class JavascriptBindings : public content::RenderViewObserver,
   void OnBrowserMessage(bool all_frames,
                         const base::string16& channel,
                         const base::ListValue& args);
+  void OnBrowserMessageBatch(const base::ListValue& batch);
+
+  IPCMessageBatch ipc_batch_;
+  base::OneShotTimer ipc_batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(JavascriptBindings);
 };
 
@@ -109,6 +109,8 @@ NodeBindings::NodeBindings(bool is_browser)
       message_loop_(nullptr),
       uv_loop_(uv_default_loop()),
       embed_closed_(false),
+      embed_thread_started_(false),
+      uv_running_(false),
       uv_env_(nullptr),
       weak_factory_(this) {
 }
@@ -117,7 +119,7 @@ NodeBindings::~NodeBindings() {
   // Quit the embed thread.
   embed_closed_ = true;
   // node never started
-  if (!uv_env_)
+  if (!uv_env_ || !embed_thread_started_)
     return;
   uv_sem_post(&embed_sem_);
   WakeupEmbedThread();
@@ -210,9 +212,13 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  if (!UseEmbedThread())
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -228,6 +234,12 @@ void NodeBindings::RunMessageLoop() {
 void NodeBindings::UvRunOnce() {
   DCHECK(!is_browser_ || BrowserThread::CurrentlyOn(BrowserThread::UI));
 
+  // uv_run isn't reentrant. A nested message loop that runs tasks, like one
+  // spun by a synchronous call from script, can get here while it is still
+  // on the stack, and the outer run picks the events up instead.
+  if (uv_running_)
+    return;
+
   node::Environment* env = uv_env();
 
   // Use Locker in browser process.
@@ -242,12 +254,38 @@ void NodeBindings::UvRunOnce() {
                                    v8::MicrotasksScope::kRunMicrotasks);
 
   // Deal with uv events.
+  for (UvRunObserver& observer : uv_run_observers_)
+    observer.WillRunUvLoop();
+
+  uv_running_ = true;
   int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  uv_running_ = false;
   if (r == 0)
     message_loop_->QuitWhenIdle();  // Quit from uv.
 
+  for (UvRunObserver& observer : uv_run_observers_)
+    observer.DidRunUvLoop();
+
+  DidRunUvLoop();
+
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (embed_thread_started_)
+    uv_sem_post(&embed_sem_);
+}
+
+void NodeBindings::AddUvRunObserver(UvRunObserver* observer) {
+  uv_run_observers_.AddObserver(observer);
+}
+
+void NodeBindings::RemoveUvRunObserver(UvRunObserver* observer) {
+  uv_run_observers_.RemoveObserver(observer);
+}
+
+bool NodeBindings::UseEmbedThread() {
+  return true;
+}
+
+void NodeBindings::DidRunUvLoop() {
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -7,6 +7,7 @@
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/observer_list.h"
 #include "v8/include/v8.h"
 #include "vendor/node/deps/uv/include/uv.h"
 
@@ -22,6 +23,17 @@ namespace atom {
 
 class NodeBindings {
  public:
+  // Observes the runs of the uv loop on the main thread. Node's timer and
+  // io callbacks run inside them.
+  class UvRunObserver {
+   public:
+    virtual void WillRunUvLoop() {}
+    virtual void DidRunUvLoop() {}
+
+   protected:
+    virtual ~UvRunObserver() {}
+  };
+
   static NodeBindings* Create(bool is_browser);
 
   virtual ~NodeBindings();
@@ -45,12 +57,22 @@ class NodeBindings {
   void set_uv_env(node::Environment* env) { uv_env_ = env; }
   node::Environment* uv_env() const { return uv_env_; }
 
+  void AddUvRunObserver(UvRunObserver* observer);
+  void RemoveUvRunObserver(UvRunObserver* observer);
+
  protected:
   explicit NodeBindings(bool is_browser);
 
+  // Whether uv events are polled on the embed thread. Implementations that
+  // watch the uv backend fd from the main thread's message pump return false.
+  virtual bool UseEmbedThread();
+
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Called on the main thread after each run of the uv loop.
+  virtual void DidRunUvLoop();
+
   // Run the libuv loop for once.
   void UvRunOnce();
 
@@ -76,6 +98,12 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_;
 
+  // Whether the embed thread was started by PrepareMessageLoop.
+  bool embed_thread_started_;
+
+  // Whether uv_run is on the stack.
+  bool uv_running_;
+
   // Dummy handle to make uv's loop not quit.
   uv_async_t dummy_uv_handle_;
 
@@ -88,6 +116,8 @@ class NodeBindings {
   // Environment that to wrap the uv loop.
   node::Environment* uv_env_;
 
+  base::ObserverList<UvRunObserver> uv_run_observers_;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindings);
@@ -6,6 +6,12 @@
 
 #include <sys/epoll.h>
 
+#if defined(USE_GLIB)
+#include <glib-unix.h>
+#endif
+
+#include "base/bind.h"
+
 namespace atom {
 
 NodeBindingsLinux::NodeBindingsLinux(bool is_browser)
@@ -19,6 +25,10 @@ NodeBindingsLinux::NodeBindingsLinux(bool is_browser)
 }
 
 NodeBindingsLinux::~NodeBindingsLinux() {
+#if defined(USE_GLIB)
+  if (backend_fd_source_)
+    g_source_remove(backend_fd_source_);
+#endif
 }
 
 void NodeBindingsLinux::RunMessageLoop() {
@@ -26,6 +36,14 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+#if defined(USE_GLIB)
+  // The browser's UI thread runs a GLib message pump, so uv's backend fd can
+  // be watched there directly. uv events are then handled as soon as the fd
+  // is readable, instead of being passed through the embed thread.
+  if (!UseEmbedThread())
+    WatchBackendFd();
+#endif
+
   NodeBindings::RunMessageLoop();
 }
 
@@ -34,10 +52,45 @@ void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
   // We need to break the io polling in the epoll thread when loop's watcher
-  // queue changes, otherwise new events cannot be notified.
+  // queue changes, otherwise new events cannot be notified. Without the
+  // embed thread this makes the backend fd readable, so that the new
+  // watchers are added to it by the next uv_run.
   self->WakeupEmbedThread();
 }
 
+#if defined(USE_GLIB)
+void NodeBindingsLinux::WatchBackendFd() {
+  if (backend_fd_source_)
+    return;
+  backend_fd_source_ = g_unix_fd_add(uv_backend_fd(uv_loop_), G_IO_IN,
+                                     OnBackendFdReady, this);
+}
+
+// static
+gboolean NodeBindingsLinux::OnBackendFdReady(gint fd,
+                                             GIOCondition condition,
+                                             gpointer data) {
+  NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(data);
+
+  // GLib also dispatches this source from nested native loops, like the one
+  // gtk_dialog_run spins for a synchronous dialog, where uv_run may still be
+  // on the stack. So uv is run from a posted task, which those loops don't
+  // run. The fd stays readable until then, so the source is removed until
+  // the run has finished.
+  self->backend_fd_source_ = 0;
+  self->WakeupMainThread();
+  return G_SOURCE_REMOVE;
+}
+#endif
+
+bool NodeBindingsLinux::UseEmbedThread() {
+#if defined(USE_GLIB)
+  return !is_browser_;
+#else
+  return true;
+#endif
+}
+
 void NodeBindingsLinux::PollEvents() {
   int timeout = uv_backend_timeout(uv_loop_);
 
@@ -49,6 +102,30 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+void NodeBindingsLinux::DidRunUvLoop() {
+  if (UseEmbedThread())
+    return;
+
+#if defined(USE_GLIB)
+  WatchBackendFd();
+#endif
+
+  // The backend fd only reports io, so run the loop again when the next
+  // timer is due.
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout < 0) {
+    uv_timer_.Stop();
+    return;
+  }
+  uv_timer_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(timeout),
+                  base::Bind(&NodeBindingsLinux::RunUvLoop,
+                             base::Unretained(this)));
+}
+
+void NodeBindingsLinux::RunUvLoop() {
+  UvRunOnce();
+}
+
 // static
 NodeBindings* NodeBindings::Create(bool is_browser) {
   return new NodeBindingsLinux(is_browser);
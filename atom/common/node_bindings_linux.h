@@ -7,6 +7,11 @@
 
 #include "atom/common/node_bindings.h"
 #include "base/compiler_specific.h"
+#include "base/timer/timer.h"
+
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
 
 namespace atom {
 
@@ -21,11 +26,34 @@ class NodeBindingsLinux : public NodeBindings {
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
+#if defined(USE_GLIB)
+  // Adds the source watching uv's backend fd, unless it is already there.
+  void WatchBackendFd();
+
+  // Called by the GLib main loop when uv's backend fd is readable.
+  static gboolean OnBackendFdReady(gint fd,
+                                   GIOCondition condition,
+                                   gpointer data);
+#endif
+
+  bool UseEmbedThread() override;
   void PollEvents() override;
+  void DidRunUvLoop() override;
+
+  void RunUvLoop();
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+#if defined(USE_GLIB)
+  // The source watching uv's backend fd in the main thread's GLib context,
+  // when there is no embed thread. It is 0 while a uv run is pending.
+  guint backend_fd_source_ = 0;
+#endif
+
+  // Fires when the next uv timer is due, when there is no embed thread.
+  base::OneShotTimer uv_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
@@ -128,6 +128,13 @@ const char kAppUserModelId[] = "app-user-model-id";
 const char kBackgroundColor[] = "background-color";
 const char kZoomFactor[]      = "zoom-factor";
 
+// Number of renderer processes to keep started ahead of time for new tabs in
+// each session.
+const char kSpareRendererCount[] = "spare-renderer-count";
+
+// Path to write the startup timeline to once the first window has painted.
+const char kStartupTimeline[] = "startup-timeline";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -73,6 +73,8 @@ extern const char kAppUserModelId[];
 extern const char kBackgroundColor[];
 extern const char kZoomFactor[];
 extern const char kGuestInstanceID[];
+extern const char kSpareRendererCount[];
+extern const char kStartupTimeline[];
 
 extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
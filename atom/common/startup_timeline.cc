@@ -0,0 +1,217 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "atom/common/startup_timeline.h"
+
+#include <utility>
+
+#include "base/process/process_info.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace atom {
+
+namespace {
+
+// Keeps the timeline bounded if something records phases in a loop.
+const size_t kMaxEvents = 1000;
+
+base::LazyInstance<StartupTimeline>::Leaky g_startup_timeline =
+    LAZY_INSTANCE_INITIALIZER;
+
+#if defined(OS_WIN)
+base::TimeDelta FileTimeToTimeDelta(const FILETIME& file_time) {
+  ULARGE_INTEGER value;
+  value.LowPart = file_time.dwLowDateTime;
+  value.HighPart = file_time.dwHighDateTime;
+  // FILETIME counts 100ns intervals.
+  return base::TimeDelta::FromMicroseconds(value.QuadPart / 10);
+}
+#else
+base::TimeDelta TimeValToTimeDelta(const struct timeval& time) {
+  return base::TimeDelta::FromSeconds(time.tv_sec) +
+      base::TimeDelta::FromMicroseconds(time.tv_usec);
+}
+#endif
+
+void SetCounter(base::DictionaryValue* dict, const char* key,
+                int64_t start, int64_t end) {
+  if (start >= 0 && end >= 0)
+    dict->SetDouble(key, static_cast<double>(end - start));
+}
+
+}  // namespace
+
+StartupTimeline::ScopedPhase::ScopedPhase(const char* name)
+    : name_(name),
+      index_(StartupTimeline::GetInstance()->BeginPhase(name)) {
+  TRACE_EVENT_BEGIN0("startup", name_);
+}
+
+StartupTimeline::ScopedPhase::~ScopedPhase() {
+  TRACE_EVENT_END0("startup", name_);
+  StartupTimeline::GetInstance()->EndPhase(index_);
+}
+
+StartupTimeline::ResourceUsage::ResourceUsage()
+    : page_faults(-1),
+      hard_page_faults(-1),
+      disk_reads(-1) {
+}
+
+StartupTimeline::Event::Event()
+    : name(nullptr),
+      is_phase(false) {
+}
+
+// static
+StartupTimeline* StartupTimeline::GetInstance() {
+  return g_startup_timeline.Pointer();
+}
+
+StartupTimeline::StartupTimeline()
+    : origin_time_(base::Time::Now()),
+      origin_ticks_(base::TimeTicks::Now()),
+      finished_(false) {
+}
+
+StartupTimeline::~StartupTimeline() {
+}
+
+int StartupTimeline::BeginPhase(const char* name) {
+  ResourceUsage usage = GetResourceUsage();
+  base::AutoLock lock(lock_);
+  if (finished_ || events_.size() >= kMaxEvents)
+    return -1;
+
+  Event event;
+  event.name = name;
+  event.is_phase = true;
+  event.start_time = base::TimeTicks::Now();
+  event.start_usage = usage;
+  events_.push_back(event);
+  return static_cast<int>(events_.size() - 1);
+}
+
+void StartupTimeline::EndPhase(int index) {
+  if (index < 0)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  ResourceUsage usage = GetResourceUsage();
+  base::AutoLock lock(lock_);
+  events_[index].end_time = now;
+  events_[index].end_usage = usage;
+}
+
+void StartupTimeline::Finish(const char* name) {
+  TRACE_EVENT_INSTANT0("startup", name, TRACE_EVENT_SCOPE_PROCESS);
+
+  Event event;
+  event.name = name;
+  event.start_time = event.end_time = base::TimeTicks::Now();
+  event.end_usage = GetResourceUsage();
+
+  base::AutoLock lock(lock_);
+  if (finished_)
+    return;
+  events_.push_back(event);
+  finished_ = true;
+}
+
+bool StartupTimeline::IsFinished() const {
+  base::AutoLock lock(lock_);
+  return finished_;
+}
+
+std::unique_ptr<base::DictionaryValue> StartupTimeline::ToValue() const {
+  base::AutoLock lock(lock_);
+  std::unique_ptr<base::DictionaryValue> timeline(new base::DictionaryValue);
+  timeline->SetDouble("processCreationTime", GetCreationTime().ToJsTime());
+  if (finished_) {
+    timeline->SetDouble("timeToFirstWindow",
+                        ToProcessTime(events_.back().start_time));
+  }
+
+  std::unique_ptr<base::ListValue> events(new base::ListValue);
+  for (const Event& event : events_) {
+    // Phases that are still running are left out.
+    if (event.end_time.is_null())
+      continue;
+
+    std::unique_ptr<base::DictionaryValue> value(new base::DictionaryValue);
+    value->SetString("name", event.name);
+    value->SetString("type", event.is_phase ? "phase" : "mark");
+    value->SetDouble("start", ToProcessTime(event.start_time));
+    value->SetDouble("duration",
+                     (event.end_time - event.start_time).InMillisecondsF());
+
+    const ResourceUsage& start = event.start_usage;
+    const ResourceUsage& end = event.end_usage;
+    value->SetDouble("cpuTime",
+                     (end.cpu_time - start.cpu_time).InMillisecondsF());
+    SetCounter(value.get(), "pageFaults",
+               event.is_phase ? start.page_faults : 0, end.page_faults);
+    SetCounter(value.get(), "hardPageFaults",
+               event.is_phase ? start.hard_page_faults : 0,
+               end.hard_page_faults);
+    SetCounter(value.get(), "diskReads",
+               event.is_phase ? start.disk_reads : 0, end.disk_reads);
+    events->Append(std::move(value));
+  }
+  timeline->Set("events", std::move(events));
+  return timeline;
+}
+
+base::Time StartupTimeline::GetCreationTime() const {
+  base::Time creation_time = base::CurrentProcessInfo::CreationTime();
+  if (creation_time.is_null() || creation_time > origin_time_)
+    return origin_time_;
+  return creation_time;
+}
+
+double StartupTimeline::ToProcessTime(base::TimeTicks time) const {
+  return ((time - origin_ticks_) + (origin_time_ - GetCreationTime()))
+      .InMillisecondsF();
+}
+
+// static
+StartupTimeline::ResourceUsage StartupTimeline::GetResourceUsage() {
+  ResourceUsage usage;
+#if defined(OS_WIN)
+  HANDLE process = ::GetCurrentProcess();
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (::GetProcessTimes(process, &creation_time, &exit_time, &kernel_time,
+                        &user_time)) {
+    usage.cpu_time =
+        FileTimeToTimeDelta(kernel_time) + FileTimeToTimeDelta(user_time);
+  }
+  PROCESS_MEMORY_COUNTERS memory_counters;
+  if (::GetProcessMemoryInfo(process, &memory_counters,
+                             sizeof(memory_counters)))
+    usage.page_faults = memory_counters.PageFaultCount;
+  IO_COUNTERS io_counters;
+  if (::GetProcessIoCounters(process, &io_counters))
+    usage.disk_reads = io_counters.ReadOperationCount;
+#else
+  struct rusage rusage;
+  if (getrusage(RUSAGE_SELF, &rusage) == 0) {
+    usage.cpu_time = TimeValToTimeDelta(rusage.ru_utime) +
+        TimeValToTimeDelta(rusage.ru_stime);
+    usage.page_faults = rusage.ru_minflt + rusage.ru_majflt;
+    usage.hard_page_faults = rusage.ru_majflt;
+    usage.disk_reads = rusage.ru_inblock;
+  }
+#endif
+  return usage;
+}
+
+}  // namespace atom
@@ -0,0 +1,110 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_STARTUP_TIMELINE_H_
+#define ATOM_COMMON_STARTUP_TIMELINE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace atom {
+
+// Records the phases of startup, both as trace events in the "startup"
+// category and in a timeline that can be read without tracing, so that it can
+// be collected from the field. Each phase records its wall time along with
+// the CPU time, page faults and disk reads of the process while it ran.
+// Recording stops once the first window has painted.
+class StartupTimeline {
+ public:
+  // Records the lifetime of the object as a phase. |name| must be a string
+  // literal.
+  class ScopedPhase {
+   public:
+    explicit ScopedPhase(const char* name);
+    ~ScopedPhase();
+
+   private:
+    const char* name_;
+    int index_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+  static StartupTimeline* GetInstance();
+
+  // Records an instant event and stops recording. |name| must be a string
+  // literal.
+  void Finish(const char* name);
+  bool IsFinished() const;
+
+  // Times are in milliseconds since the process was created. Phases report
+  // the resources used while they ran, and the final mark reports the totals
+  // up to that point.
+  std::unique_ptr<base::DictionaryValue> ToValue() const;
+
+ private:
+  friend struct base::DefaultLazyInstanceTraits<StartupTimeline>;
+
+  struct ResourceUsage {
+    ResourceUsage();
+
+    base::TimeDelta cpu_time;
+    // -1 where the platform doesn't report the counter.
+    int64_t page_faults;
+    int64_t hard_page_faults;
+    int64_t disk_reads;
+  };
+
+  struct Event {
+    Event();
+
+    const char* name;
+    bool is_phase;
+    base::TimeTicks start_time;
+    base::TimeTicks end_time;
+    ResourceUsage start_usage;
+    ResourceUsage end_usage;
+  };
+
+  StartupTimeline();
+  ~StartupTimeline();
+
+  // Returns -1 once recording has stopped.
+  int BeginPhase(const char* name);
+  void EndPhase(int index);
+
+  static ResourceUsage GetResourceUsage();
+
+  // Falls back to the time the timeline was created where the platform
+  // doesn't report when the process was created.
+  base::Time GetCreationTime() const;
+  double ToProcessTime(base::TimeTicks time) const;
+
+  mutable base::Lock lock_;
+
+  // The process creation time is only available as wall clock time, so the
+  // tick clock is anchored to the wall clock once.
+  base::Time origin_time_;
+  base::TimeTicks origin_ticks_;
+
+  std::vector<Event> events_;
+  bool finished_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_STARTUP_TIMELINE_H_
@@ -8,7 +8,9 @@
 #include "brave/browser/brave_browser_context.h"
 
 #include "atom/browser/net/atom_url_request_job_factory.h"
+#include "atom/common/startup_timeline.h"
 #include "base/path_service.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "brave/browser/brave_permission_manager.h"
@@ -92,6 +94,9 @@ namespace brave {
 const char kPersistPrefix[] = "persist:";
 const int kPersistPrefixLength = 8;
 
+// Set in the options of partitions created by FromPartitionAsync.
+const char kAsyncPrefsOption[] = "async_prefs";
+
 void DatabaseErrorCallback(sql::InitStatus init_status,
                            const std::string& diagnostics) {
   LOG(WARNING) << "initializing autocomplete database failed";
@@ -121,7 +126,13 @@ BraveBrowserContext::BraveBrowserContext(const std::string& partition,
         atom::AtomBrowserContext::From(partition, false).get());
     original_context_->otr_context_ = this;
   }
-  CreateProfilePrefs(task_runner);
+  // The prefs are layered on top of the original context's prefs, so
+  // FromPartition and FromPartitionAsync only get here once those are loaded.
+  DCHECK(!original_context_ || original_context_->ready()->IsSignaled());
+
+  bool async_prefs = false;
+  options.GetBoolean(kAsyncPrefsOption, &async_prefs);
+  CreateProfilePrefs(task_runner, async_prefs);
   if (original_context_) {
     TrackZoomLevelsFromParent();
   }
@@ -164,8 +175,10 @@ BraveBrowserContext::~BraveBrowserContext() {
   }
 
   if (!IsOffTheRecord() && !HasParentContext()) {
-    autofill_data_->ShutdownOnUIThread();
-    web_database_->ShutdownDatabase();
+    if (autofill_data_)
+      autofill_data_->ShutdownOnUIThread();
+    if (web_database_)
+      web_database_->ShutdownDatabase();
 
     bool prefs_loaded = user_prefs_->GetInitializationStatus() !=
         PrefService::INITIALIZATION_STATUS_WAITING;
@@ -350,7 +363,8 @@ BraveBrowserContext::CreateURLRequestJobFactory(
 }
 
 void BraveBrowserContext::CreateProfilePrefs(
-    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    bool async) {
   InitPrefs(task_runner);
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   PrefStore* extension_prefs = new ExtensionPrefStore(
@@ -361,8 +375,6 @@ void BraveBrowserContext::CreateProfilePrefs(
 #endif
   user_prefs_registrar_.reset(new PrefChangeRegistrar());
 
-  bool async = false;
-
   if (IsOffTheRecord()) {
     overlay_pref_names_.push_back("app_state");
     overlay_pref_names_.push_back("content_settings");
@@ -441,23 +453,6 @@ void BraveBrowserContext::OnPrefsLoaded(bool success) {
 #endif
     content::BrowserContext::GetDefaultStoragePartition(this)->
         GetDOMStorageContext()->SetSaveSessionStorageOnDisk();
-
-    // Initialize autofill db
-    base::FilePath webDataPath = GetPath().Append(kWebDataFilename);
-
-    CHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
-    web_database_ = new WebDatabaseService(webDataPath,
-        BrowserThread::GetTaskRunnerForThread(BrowserThread::UI),
-        BrowserThread::GetTaskRunnerForThread(BrowserThread::DB));
-    web_database_->AddTable(base::WrapUnique(new autofill::AutofillTable));
-    web_database_->LoadDatabase();
-
-    autofill_data_ = new autofill::AutofillWebDataService(
-        web_database_,
-        BrowserThread::GetTaskRunnerForThread(BrowserThread::UI),
-        BrowserThread::GetTaskRunnerForThread(BrowserThread::DB),
-        base::Bind(&DatabaseErrorCallback));
-    autofill_data_->Init();
   }
 
   user_prefs_registrar_->Init(user_prefs_.get());
@@ -471,6 +466,42 @@ void BraveBrowserContext::OnPrefsLoaded(bool success) {
       chrome::NOTIFICATION_PROFILE_CREATED,
       content::Source<BraveBrowserContext>(this),
       content::NotificationService::NoDetails());
+
+  std::vector<base::Closure> ready_callbacks;
+  ready_callbacks.swap(ready_callbacks_);
+  for (const base::Closure& callback : ready_callbacks)
+    callback.Run();
+}
+
+void BraveBrowserContext::AddReadyCallback(const base::Closure& callback) {
+  if (ready_->IsSignaled()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, callback);
+    return;
+  }
+  ready_callbacks_.push_back(callback);
+}
+
+void BraveBrowserContext::InitWebDatabase() {
+  DCHECK(!IsOffTheRecord() && !HasParentContext());
+  if (web_database_)
+    return;
+
+  // Initialize autofill db
+  base::FilePath webDataPath = GetPath().Append(kWebDataFilename);
+
+  CHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  web_database_ = new WebDatabaseService(webDataPath,
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::UI),
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::DB));
+  web_database_->AddTable(base::WrapUnique(new autofill::AutofillTable));
+  web_database_->LoadDatabase();
+
+  autofill_data_ = new autofill::AutofillWebDataService(
+      web_database_,
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::UI),
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::DB),
+      base::Bind(&DatabaseErrorCallback));
+  autofill_data_->Init();
 }
 
 content::ResourceContext* BraveBrowserContext::GetResourceContext() {
@@ -488,9 +519,16 @@ BraveBrowserContext::CreateZoomLevelDelegate(
 
 scoped_refptr<autofill::AutofillWebDataService>
 BraveBrowserContext::GetAutofillWebdataService() {
+  original_context()->InitWebDatabase();
   return original_context()->autofill_data_;
 }
 
+scoped_refptr<WebDatabaseService>
+BraveBrowserContext::GetWebDatabaseService() {
+  original_context()->InitWebDatabase();
+  return original_context()->web_database_;
+}
+
 base::FilePath BraveBrowserContext::GetPath() const {
   return brightray::BrowserContext::GetPath();
 }
@@ -506,60 +544,120 @@ std::string BraveBrowserContext::partition_with_prefix() {
   return kPersistPrefix + canonical_partition;
 }
 
+// static
 scoped_refptr<atom::AtomBrowserContext> BraveBrowserContext::FromPartition(
     const std::string& partition, const base::DictionaryValue& options) {
-  scoped_refptr<atom::AtomBrowserContext> browser_context;
-  if (partition.empty()) {
-    return atom::AtomBrowserContext::From("", false, options);
+  // Waiting for the prefs would mean running the message loop from inside a
+  // synchronous call.
+  if (GetLoadingContext(partition, options))
+    return nullptr;
+  return GetOrCreateForPartition(partition, options);
+}
+
+// static
+void BraveBrowserContext::FromPartitionAsync(
+    const std::string& partition, const base::DictionaryValue& options,
+    const PartitionReadyCallback& callback) {
+  BraveBrowserContext* loading_context = GetLoadingContext(partition, options);
+  if (loading_context) {
+    loading_context->AddReadyCallback(
+        base::Bind(&FromPartitionAsyncWithOptions, partition,
+                   base::Owned(options.DeepCopy()), callback));
+    return;
   }
 
-  if (base::StartsWith(
+  std::unique_ptr<base::DictionaryValue> async_options(options.DeepCopy());
+  async_options->SetBoolean(kAsyncPrefsOption, true);
+  scoped_refptr<atom::AtomBrowserContext> browser_context =
+      GetOrCreateForPartition(partition, *async_options);
+  FromBrowserContext(browser_context.get())->AddReadyCallback(
+      base::Bind(callback, browser_context));
+}
+
+// static
+void BraveBrowserContext::FromPartitionAsyncWithOptions(
+    const std::string& partition, const base::DictionaryValue* options,
+    const PartitionReadyCallback& callback) {
+  FromPartitionAsync(partition, *options, callback);
+}
+
+// static
+BraveBrowserContext* BraveBrowserContext::GetLoadingContext(
+    const std::string& partition, const base::DictionaryValue& options) {
+  std::string name;
+  bool in_memory;
+  ParsePartition(partition, &name, &in_memory);
+
+  auto browser_context = brightray::BrowserContext::Get(name, in_memory);
+  if (browser_context) {
+    BraveBrowserContext* context = FromBrowserContext(browser_context.get());
+    return context->ready()->IsSignaled() ? nullptr : context;
+  }
+
+  // A new context is layered on the prefs of its original context.
+  std::string original_partition = name;
+  if (!in_memory &&
+      !options.GetString("parent_partition", &original_partition))
+    return nullptr;
+  auto original_context =
+      brightray::BrowserContext::Get(original_partition, false);
+  if (!original_context)
+    return nullptr;
+  BraveBrowserContext* context = FromBrowserContext(original_context.get());
+  return context->ready()->IsSignaled() ? nullptr : context;
+}
+
+// static
+void BraveBrowserContext::ParsePartition(const std::string& partition,
+                                         std::string* name,
+                                         bool* in_memory) {
+  if (partition.empty()) {
+    *name = std::string();
+    *in_memory = false;
+  } else if (base::StartsWith(
       partition, kPersistPrefix, base::CompareCase::SENSITIVE)) {
-    std::string name = partition.substr(kPersistPrefixLength);
-    return atom::AtomBrowserContext::From(
-        name == "default" ? "" : name, false, options);
+    *name = partition.substr(kPersistPrefixLength);
+    *in_memory = false;
   } else {
-    return atom::AtomBrowserContext::From(
-        partition == "default" ? "" : partition, true, options);
+    *name = partition;
+    *in_memory = true;
   }
+  if (*name == "default")
+    name->clear();
+}
+
+// static
+scoped_refptr<atom::AtomBrowserContext>
+BraveBrowserContext::GetOrCreateForPartition(
+    const std::string& partition, const base::DictionaryValue& options) {
+  std::string name;
+  bool in_memory;
+  ParsePartition(partition, &name, &in_memory);
+  return atom::AtomBrowserContext::From(name, in_memory, options);
 }
 
 }  // namespace brave
 
 namespace atom {
 
-void CreateDirectoryAndSignal(const base::FilePath& path,
-                              base::WaitableEvent* done_creating) {
+void CreateDirectoryIfMissing(const base::FilePath& path) {
   if (!base::PathExists(path)) {
     DVLOG(1) << "Creating directory " << path.value();
     base::CreateDirectory(path);
   }
-  done_creating->Signal();
 }
 
-// Task that blocks the FILE thread until CreateDirectoryAndSignal() finishes on
-// blocking I/O pool.
-void BlockFileThreadOnDirectoryCreate(base::WaitableEvent* done_creating) {
-  done_creating->Wait();
-}
-
-// Initiates creation of profile directory on |sequenced_task_runner| and
-// ensures that FILE thread is blocked until that operation finishes. If
-// |create_readme| is true, the profile README will be created in the profile
-// directory.
+// Creates the profile directory before any other profile file operation on
+// |sequenced_task_runner| and on the FILE thread. It is created on both rather
+// than blocking the FILE thread until the blocking pool has created it.
+// CreateDirectory succeeds when the directory was created concurrently.
 void CreateProfileDirectory(base::SequencedTaskRunner* sequenced_task_runner,
                             const base::FilePath& path) {
-  base::WaitableEvent* done_creating =
-      new base::WaitableEvent(base::WaitableEvent::ResetPolicy::AUTOMATIC,
-                              base::WaitableEvent::InitialState::NOT_SIGNALED);
   sequenced_task_runner->PostTask(
-      FROM_HERE, base::Bind(&CreateDirectoryAndSignal, path, done_creating));
-  // Block the FILE thread until directory is created on I/O pool to make sure
-  // that we don't attempt any operation until that part completes.
+      FROM_HERE, base::Bind(&CreateDirectoryIfMissing, path));
   BrowserThread::PostTask(
       BrowserThread::FILE, FROM_HERE,
-      base::Bind(&BlockFileThreadOnDirectoryCreate,
-                 base::Owned(done_creating)));
+      base::Bind(&CreateDirectoryIfMissing, path));
 }
 
 // TODO(bridiver) find a better way to do this
@@ -571,6 +669,8 @@ scoped_refptr<AtomBrowserContext> AtomBrowserContext::From(
   if (browser_context)
     return static_cast<AtomBrowserContext*>(browser_context.get());
 
+  atom::StartupTimeline::ScopedPhase phase("AtomBrowserContext::From");
+
   // TODO(bridiver) - pass the path to initialize the browser context
   // TODO(bridiver) - create these with the profile manager
   base::FilePath path;
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "atom/browser/atom_browser_context.h"
+#include "base/callback.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "chrome/browser/custom_handlers/protocol_handler_registry.h"
 #include "chrome/browser/profiles/profile.h"
@@ -43,8 +44,20 @@ class BraveBrowserContext : public Profile {
   std::unique_ptr<content::ZoomLevelDelegate> CreateZoomLevelDelegate(
       const base::FilePath& partition_path) override;
 
+  using PartitionReadyCallback =
+      base::Callback<void(scoped_refptr<atom::AtomBrowserContext>)>;
+
+  // Returns the browser context for |partition|, creating it if needed.
+  // Returns null if the context, or the one it would be layered on, is still
+  // being loaded by FromPartitionAsync.
   static scoped_refptr<atom::AtomBrowserContext> FromPartition(
     const std::string& partition, const base::DictionaryValue& options);
+  // Like FromPartition, but the prefs of a new persistent context are loaded
+  // off the UI thread and |callback| runs once the context is ready. A
+  // context that is still loading is waited for.
+  static void FromPartitionAsync(
+    const std::string& partition, const base::DictionaryValue& options,
+    const PartitionReadyCallback& callback);
 
   static BraveBrowserContext*
       FromBrowserContext(content::BrowserContext* browser_context);
@@ -53,7 +66,8 @@ class BraveBrowserContext : public Profile {
   std::unique_ptr<net::URLRequestJobFactory> CreateURLRequestJobFactory(
       content::ProtocolHandlerMap* protocol_handlers) override;
 
-  void CreateProfilePrefs(scoped_refptr<base::SequencedTaskRunner> task_runner);
+  void CreateProfilePrefs(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                          bool async);
 
   ChromeZoomLevelPrefs* GetZoomLevelPrefs() override;
 
@@ -96,12 +110,17 @@ class BraveBrowserContext : public Profile {
   const std::string& partition() const { return partition_; }
   std::string partition_with_prefix();
   base::WaitableEvent* ready() { return ready_.get(); }
+  // Runs |callback| once the prefs are loaded and the services created,
+  // asynchronously if that has already happened.
+  void AddReadyCallback(const base::Closure& callback);
 
   void AddOverlayPref(const std::string name) override {
     overlay_pref_names_.push_back(name.c_str()); }
 
   scoped_refptr<autofill::AutofillWebDataService>
     GetAutofillWebdataService() override;
+  // The web database is opened on first use.
+  scoped_refptr<WebDatabaseService> GetWebDatabaseService();
 
   base::FilePath GetPath() const override;
 
@@ -111,7 +130,20 @@ class BraveBrowserContext : public Profile {
   }
 
  private:
+  static void FromPartitionAsyncWithOptions(
+    const std::string& partition, const base::DictionaryValue* options,
+    const PartitionReadyCallback& callback);
+  // Returns the context that getting |partition| has to wait for, if any.
+  static BraveBrowserContext* GetLoadingContext(
+    const std::string& partition, const base::DictionaryValue& options);
+  static void ParsePartition(const std::string& partition,
+                             std::string* name,
+                             bool* in_memory);
+  static scoped_refptr<atom::AtomBrowserContext> GetOrCreateForPartition(
+    const std::string& partition, const base::DictionaryValue& options);
+
   void OnPrefsLoaded(bool success);
+  void InitWebDatabase();
   void TrackZoomLevelsFromParent();
   void OnParentZoomLevelChanged(
       const content::HostZoomMap::ZoomLevelChange& change);
@@ -133,6 +165,7 @@ class BraveBrowserContext : public Profile {
   BraveBrowserContext* otr_context_;
   const std::string partition_;
   std::unique_ptr<base::WaitableEvent> ready_;
+  std::vector<base::Closure> ready_callbacks_;
 
   scoped_refptr<autofill::AutofillWebDataService> autofill_data_;
   scoped_refptr<WebDatabaseService> web_database_;
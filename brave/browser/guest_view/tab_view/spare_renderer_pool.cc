@@ -0,0 +1,209 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "brave/browser/guest_view/tab_view/spare_renderer_pool.h"
+
+#include "atom/browser/atom_browser_context.h"
+#include "atom/browser/atom_browser_main_parts.h"
+#include "atom/browser/idle_gc_scheduler.h"
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+
+namespace brave {
+
+namespace {
+
+const size_t kDefaultPoolSize = 1;
+
+// Spares are kept for at most this many browser contexts, the ones tabs were
+// most recently opened in.
+const size_t kMaxBrowserContexts = 2;
+
+base::LazyInstance<SpareRendererPool>::Leaky g_spare_renderer_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+size_t GetPoolSize() {
+  auto command_line = base::CommandLine::ForCurrentProcess();
+  size_t pool_size = kDefaultPoolSize;
+  if (command_line->HasSwitch(atom::switches::kSpareRendererCount)) {
+    base::StringToSizeT(command_line->GetSwitchValueASCII(
+        atom::switches::kSpareRendererCount), &pool_size);
+  }
+  return pool_size;
+}
+
+bool HasLiveProcess(content::SiteInstance* site_instance) {
+  return site_instance->HasProcess() &&
+      site_instance->GetProcess()->HasConnection();
+}
+
+}  // namespace
+
+SpareRendererPool::Spares::Spares() : refill_pending(false) {
+}
+
+SpareRendererPool::Spares::~Spares() {
+}
+
+// static
+SpareRendererPool* SpareRendererPool::GetInstance() {
+  return g_spare_renderer_pool.Pointer();
+}
+
+SpareRendererPool::SpareRendererPool()
+    : pool_size_(GetPoolSize()),
+      registered_for_shutdown_(false),
+      weak_factory_(this) {
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&SpareRendererPool::OnMemoryPressure,
+        base::Unretained(this))));
+}
+
+SpareRendererPool::~SpareRendererPool() {
+}
+
+scoped_refptr<content::SiteInstance> SpareRendererPool::TakeSpare(
+    atom::AtomBrowserContext* browser_context) {
+  if (pool_size_ == 0 || browser_context->IsOffTheRecord())
+    return nullptr;
+
+  if (!registered_for_shutdown_) {
+    // The spares hold browser contexts, which have to go away with the rest
+    // of the browser objects.
+    atom::AtomBrowserMainParts::Get()->RegisterDestructionCallback(
+        base::Bind(&SpareRendererPool::Clear, weak_factory_.GetWeakPtr()));
+    registered_for_shutdown_ = true;
+  }
+
+  if (!spares_.count(browser_context) &&
+      spares_.size() >= kMaxBrowserContexts)
+    ReleaseLeastRecentlyUsed();
+
+  std::unique_ptr<Spares>& spares = spares_[browser_context];
+  if (!spares) {
+    spares.reset(new Spares);
+    spares->browser_context = browser_context;
+  }
+  spares->last_used = base::TimeTicks::Now();
+
+  scoped_refptr<content::SiteInstance> site_instance;
+  while (!site_instance && !spares->site_instances.empty()) {
+    site_instance = spares->site_instances.front();
+    spares->site_instances.pop_front();
+    // The process may have crashed since it was started.
+    if (!HasLiveProcess(site_instance.get())) {
+      ReleaseSpare(site_instance.get());
+      site_instance = nullptr;
+    }
+  }
+
+  ScheduleRefill(spares.get());
+  return site_instance;
+}
+
+void SpareRendererPool::TabCreated(atom::AtomBrowserContext* browser_context) {
+  if (pool_size_ == 0 || browser_context->IsOffTheRecord())
+    return;
+
+  ++tab_counts_[browser_context];
+}
+
+void SpareRendererPool::TabDestroyed(
+    atom::AtomBrowserContext* browser_context) {
+  auto it = tab_counts_.find(browser_context);
+  if (it == tab_counts_.end())
+    return;
+
+  if (--it->second > 0)
+    return;
+
+  tab_counts_.erase(it);
+  Release(browser_context);
+}
+
+void SpareRendererPool::ScheduleRefill(Spares* spares) {
+  if (spares->refill_pending)
+    return;
+
+  spares->refill_pending = true;
+  // The launch waits for the UI thread to go idle so that it doesn't compete
+  // with loading the tab that took the spare.
+  base::Closure refill = base::Bind(&SpareRendererPool::Refill,
+      weak_factory_.GetWeakPtr(), spares->browser_context.get());
+  atom::IdleGCScheduler* idle_scheduler = atom::IdleGCScheduler::current();
+  if (idle_scheduler)
+    idle_scheduler->PostIdleTask(refill);
+  else
+    base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, refill);
+}
+
+void SpareRendererPool::Refill(atom::AtomBrowserContext* browser_context) {
+  auto it = spares_.find(browser_context);
+  if (it == spares_.end())
+    return;
+
+  Spares* spares = it->second.get();
+  spares->refill_pending = false;
+  while (spares->site_instances.size() < pool_size_) {
+    scoped_refptr<content::SiteInstance> site_instance =
+        content::SiteInstance::Create(browser_context);
+    if (!site_instance->GetProcess()->Init()) {
+      ReleaseSpare(site_instance.get());
+      break;
+    }
+    spares->site_instances.push_back(site_instance);
+  }
+}
+
+void SpareRendererPool::Release(atom::AtomBrowserContext* browser_context) {
+  auto it = spares_.find(browser_context);
+  if (it == spares_.end())
+    return;
+
+  for (const auto& site_instance : it->second->site_instances)
+    ReleaseSpare(site_instance.get());
+  spares_.erase(it);
+}
+
+void SpareRendererPool::ReleaseLeastRecentlyUsed() {
+  while (!spares_.empty() && spares_.size() >= kMaxBrowserContexts) {
+    auto least_recently_used = spares_.begin();
+    for (auto it = spares_.begin(); it != spares_.end(); ++it) {
+      if (it->second->last_used < least_recently_used->second->last_used)
+        least_recently_used = it;
+    }
+    Release(least_recently_used->first);
+  }
+}
+
+void SpareRendererPool::Clear() {
+  for (const auto& it : spares_) {
+    for (const auto& site_instance : it.second->site_instances)
+      ReleaseSpare(site_instance.get());
+  }
+  spares_.clear();
+}
+
+void SpareRendererPool::ReleaseSpare(content::SiteInstance* site_instance) {
+  // A process that never hosted a page isn't cleaned up on its own. This is
+  // a no-op if content has since put a page in it.
+  if (site_instance->HasProcess())
+    site_instance->GetProcess()->Cleanup();
+}
+
+void SpareRendererPool::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+
+  Clear();
+}
+
+}  // namespace brave
@@ -0,0 +1,97 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BRAVE_BROWSER_GUEST_VIEW_TAB_VIEW_SPARE_RENDERER_POOL_H_
+#define BRAVE_BROWSER_GUEST_VIEW_TAB_VIEW_SPARE_RENDERER_POOL_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+
+#include "base/lazy_instance.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+namespace atom {
+class AtomBrowserContext;
+}
+
+namespace content {
+class SiteInstance;
+}
+
+namespace brave {
+
+// Keeps renderer processes launched ahead of time for the few browser
+// contexts that tabs were most recently opened in, so that a new tab doesn't
+// wait for a process to start. Spares are refilled once the UI thread is idle
+// after one is taken, and released under memory pressure or when the last tab
+// of their browser context closes. The number of spares per browser context
+// is set with the --spare-renderer-count switch and defaults to 1. Off the
+// record contexts don't get spares so that the pool never keeps them alive.
+class SpareRendererPool {
+ public:
+  static SpareRendererPool* GetInstance();
+
+  // Returns a SiteInstance whose process is already running, or null if
+  // there is no spare for |browser_context|. Either way a refill is
+  // scheduled.
+  scoped_refptr<content::SiteInstance> TakeSpare(
+      atom::AtomBrowserContext* browser_context);
+
+  // Track the tabs open in each browser context, so that spares aren't kept
+  // for a context nothing uses anymore.
+  void TabCreated(atom::AtomBrowserContext* browser_context);
+  void TabDestroyed(atom::AtomBrowserContext* browser_context);
+
+ private:
+  friend struct base::DefaultLazyInstanceTraits<SpareRendererPool>;
+
+  struct Spares {
+    Spares();
+    ~Spares();
+
+    // Held so that the context outlives the processes started for it.
+    scoped_refptr<atom::AtomBrowserContext> browser_context;
+    std::deque<scoped_refptr<content::SiteInstance>> site_instances;
+    bool refill_pending;
+    base::TimeTicks last_used;
+  };
+
+  SpareRendererPool();
+  ~SpareRendererPool();
+
+  void ScheduleRefill(Spares* spares);
+  void Refill(atom::AtomBrowserContext* browser_context);
+
+  // Drops the spares of |browser_context| and the reference held for them.
+  void Release(atom::AtomBrowserContext* browser_context);
+  // Makes room for another browser context by releasing the least recently
+  // used ones.
+  void ReleaseLeastRecentlyUsed();
+  // Drops every spare and the browser context references held for them.
+  void Clear();
+  void ReleaseSpare(content::SiteInstance* site_instance);
+
+  void OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  const size_t pool_size_;
+  bool registered_for_shutdown_;
+
+  std::map<atom::AtomBrowserContext*, std::unique_ptr<Spares>> spares_;
+  std::map<atom::AtomBrowserContext*, int> tab_counts_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  base::WeakPtrFactory<SpareRendererPool> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererPool);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_GUEST_VIEW_TAB_VIEW_SPARE_RENDERER_POOL_H_
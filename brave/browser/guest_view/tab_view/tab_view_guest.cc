@@ -17,6 +17,7 @@
 #include "atom/browser/extensions/tab_helper.h"
 #include "base/memory/ptr_util.h"
 #include "brave/browser/brave_browser_context.h"
+#include "brave/browser/guest_view/tab_view/spare_renderer_pool.h"
 #include "build/build_config.h"
 #include "components/guest_view/browser/guest_view_event.h"
 #include "components/guest_view/browser/guest_view_manager.h"
@@ -188,25 +189,44 @@ void TabViewGuest::DidInitialize(const base::DictionaryValue& create_params) {
   api_web_contents_->guest_delegate_ = this;
   web_contents()->SetDelegate(api_web_contents_);
 
+  SpareRendererPool::GetInstance()->TabCreated(
+      static_cast<atom::AtomBrowserContext*>(
+          web_contents()->GetBrowserContext()));
+
   ApplyAttributes(create_params);
 }
 
 void TabViewGuest::CreateWebContents(
     const base::DictionaryValue& params,
     const WebContentsCreatedCallback& callback) {
-  v8::Isolate* isolate = v8::Isolate::GetCurrent();
-  v8::Locker locker(isolate);
-  v8::HandleScope handle_scope(isolate);
-
-  scoped_refptr<atom::AtomBrowserContext> browser_context;
-
   std::string partition;
   params.GetString("partition", &partition);
   base::DictionaryValue partition_options;
-  browser_context =
+  scoped_refptr<atom::AtomBrowserContext> browser_context =
       brave::BraveBrowserContext::FromPartition(partition, partition_options);
+  if (!browser_context) {
+    // The partition is still being loaded by session.fromPartitionAsync.
+    brave::BraveBrowserContext::FromPartitionAsync(partition,
+        partition_options,
+        base::Bind(&TabViewGuest::CreateWebContentsWithContext,
+                   weak_ptr_factory_.GetWeakPtr(), callback));
+    return;
+  }
+  CreateWebContentsWithContext(callback, browser_context);
+}
+
+void TabViewGuest::CreateWebContentsWithContext(
+    const WebContentsCreatedCallback& callback,
+    scoped_refptr<atom::AtomBrowserContext> browser_context) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
   content::WebContents::CreateParams create_params(browser_context.get());
   create_params.guest_delegate = this;
+  // Skip the process launch if a renderer was started ahead of time.
+  create_params.site_instance =
+      SpareRendererPool::GetInstance()->TakeSpare(browser_context.get());
 
   mate::Dictionary options = mate::Dictionary::CreateEmpty(isolate);
 
@@ -316,6 +336,10 @@ void TabViewGuest::WillDestroy() {
 
   if (!attached() && GetOpener())
     GetOpener()->pending_new_windows_.erase(this);
+
+  SpareRendererPool::GetInstance()->TabDestroyed(
+      static_cast<atom::AtomBrowserContext*>(
+          web_contents()->GetBrowserContext()));
 }
 
 void TabViewGuest::GuestSizeChangedDueToAutoSize(const gfx::Size& old_size,
@@ -333,7 +357,8 @@ bool TabViewGuest::IsAutoSizeSupported() const {
 TabViewGuest::TabViewGuest(WebContents* owner_web_contents)
     : GuestView<TabViewGuest>(owner_web_contents),
       api_web_contents_(nullptr),
-      clone_(false) {
+      clone_(false),
+      weak_ptr_factory_(this) {
 }
 
 TabViewGuest::~TabViewGuest() {
@@ -11,9 +11,12 @@
 #include <string>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "components/guest_view/browser/guest_view.h"
 
 namespace atom {
+class AtomBrowserContext;
 namespace api {
 class WebContents;
 }
@@ -48,6 +51,9 @@ class TabViewGuest : public guest_view::GuestView<TabViewGuest> {
       bool force_navigation);
   void NavigateGuest(const std::string& src, bool force_navigation);
   void ApplyAttributes(const base::DictionaryValue& params);
+  void CreateWebContentsWithContext(
+    const WebContentsCreatedCallback& callback,
+    scoped_refptr<atom::AtomBrowserContext> browser_context);
 
   // GuestViewBase implementation.
   void GuestDestroyed() final;
@@ -98,6 +104,8 @@ class TabViewGuest : public guest_view::GuestView<TabViewGuest> {
   using PendingWindowMap = std::map<TabViewGuest*, NewWindowInfo>;
   PendingWindowMap pending_new_windows_;
 
+  base::WeakPtrFactory<TabViewGuest> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(TabViewGuest);
 };
 
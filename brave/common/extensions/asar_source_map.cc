@@ -5,12 +5,79 @@
 #include "brave/common/extensions/asar_source_map.h"
 
 #include "atom/common/asar/asar_util.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_util.h"
+#include "base/lazy_instance.h"
 #include "base/strings/string_split.h"
+#include "base/synchronization/lock.h"
 #include "gin/converter.h"
 
 namespace brave {
 
+namespace {
+
+// The most recently required module sources are kept up to this size.
+const size_t kMaxCacheBytes = 4 * 1024 * 1024;
+
+// Module sources are shared by every JavascriptEnvironment in the process,
+// so worker isolates requiring the same module only read it from disk once.
+class ModuleSourceCache {
+ public:
+  ModuleSourceCache()
+      : sources_(SourceMap::NO_AUTO_EVICT),
+        total_bytes_(0) {}
+
+  bool Get(const base::FilePath& path, std::string* source) {
+    base::AutoLock auto_lock(lock_);
+    auto it = sources_.Get(path);
+    if (it == sources_.end())
+      return false;
+    *source = it->second;
+    return true;
+  }
+
+  void Set(const base::FilePath& path, const std::string& source) {
+    // A source that doesn't fit would only push everything else out.
+    if (source.size() > kMaxCacheBytes)
+      return;
+
+    base::AutoLock auto_lock(lock_);
+    auto it = sources_.Peek(path);
+    if (it != sources_.end()) {
+      total_bytes_ -= it->second.size();
+      sources_.Erase(it);
+    }
+    sources_.Put(path, source);
+    total_bytes_ += source.size();
+
+    while (total_bytes_ > kMaxCacheBytes) {
+      auto oldest = sources_.rbegin();
+      total_bytes_ -= oldest->second.size();
+      sources_.Erase(oldest);
+    }
+  }
+
+  void Clear() {
+    base::AutoLock auto_lock(lock_);
+    sources_.Clear();
+    total_bytes_ = 0;
+  }
+
+ private:
+  using SourceMap = base::MRUCache<base::FilePath, std::string>;
+
+  base::Lock lock_;
+  SourceMap sources_;
+  size_t total_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ModuleSourceCache);
+};
+
+base::LazyInstance<ModuleSourceCache>::Leaky g_module_source_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 AsarSourceMap::AsarSourceMap(
     const std::vector<base::FilePath>& search_paths)
     : search_paths_(search_paths) {
@@ -19,6 +86,11 @@ AsarSourceMap::AsarSourceMap(
 AsarSourceMap::~AsarSourceMap() {
 }
 
+// static
+void AsarSourceMap::ClearCache() {
+  g_module_source_cache.Get().Clear();
+}
+
 v8::Local<v8::Value> AsarSourceMap::GetSource(
     v8::Isolate* isolate,
     const std::string& name) const {
@@ -33,15 +105,20 @@ v8::Local<v8::Value> AsarSourceMap::GetSource(
 
   std::string source;
   for (size_t i = 0; i < search_paths_.size(); ++i) {
+    base::FilePath module_path = search_paths_[i].Append(path);
+    if (g_module_source_cache.Get().Get(module_path, &source))
+      return gin::StringToV8(isolate, source);
+
     base::FilePath archive;
     base::FilePath relative;
     if (asar::GetAsarArchivePath(search_paths_[i], &archive, &relative)) {
       if (!asar::ReadFileToString(search_paths_[i], &source)) {
         continue;
       }
-    } else if (!ReadFileToString(search_paths_[i].Append(path), &source)) {
+    } else if (!ReadFileToString(module_path, &source)) {
       continue;
     }
+    g_module_source_cache.Get().Set(module_path, source);
     return gin::StringToV8(isolate, source);
   }
 
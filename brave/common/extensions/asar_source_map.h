@@ -20,6 +20,10 @@ class AsarSourceMap : public extensions::ModuleSystem::SourceMap {
   explicit AsarSourceMap(const std::vector<base::FilePath>& search_paths);
   ~AsarSourceMap() override;
 
+  // Drops the module sources shared by every source map, which are otherwise
+  // kept for the most recently required modules.
+  static void ClearCache();
+
   v8::Local<v8::Value> GetSource(v8::Isolate* isolate,
                                  const std::string& name) const override;
   bool Contains(const std::string& name) const override;
@@ -0,0 +1,19 @@
+// Copyright (c) 2017 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef BRAVE_COMMON_IMPORTER_IMPORTER_CONSTANTS_H_
+#define BRAVE_COMMON_IMPORTER_IMPORTER_CONSTANTS_H_
+
+#include <stddef.h>
+
+namespace importer {
+
+// History rows and cookies are sent from the importer process and written
+// to the profile in batches of at most this many entries, so that neither
+// process has to hold a whole profile in memory.
+const size_t kMaxItemsPerBatch = 1000;
+
+}  // namespace importer
+
+#endif  // BRAVE_COMMON_IMPORTER_IMPORTER_CONSTANTS_H_
@@ -0,0 +1,145 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "brave/common/workers/v8_worker_pool.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/common/workers/v8_worker_thread.h"
+#include "brave/common/workers/worker_bindings.h"
+
+namespace brave {
+
+V8WorkerPool::QueueDepth::QueueDepth() : count_(0) {
+}
+
+V8WorkerPool::QueueDepth::~QueueDepth() {
+}
+
+void V8WorkerPool::QueueDepth::Increment() {
+  base::AtomicRefCountInc(&count_);
+}
+
+void V8WorkerPool::QueueDepth::Decrement() {
+  base::AtomicRefCountDec(&count_);
+}
+
+bool V8WorkerPool::QueueDepth::IsZero() const {
+  return base::AtomicRefCountIsZero(&count_);
+}
+
+int V8WorkerPool::QueueDepth::Get() const {
+  return base::subtle::NoBarrier_Load(&count_);
+}
+
+V8WorkerPool::V8WorkerPool(int id,
+                           const std::string& module_name,
+                           size_t max_size,
+                           atom::api::App* app)
+    : id_(id),
+      module_name_(module_name),
+      max_size_(std::max<size_t>(max_size, 1)),
+      app_(app),
+      next_worker_index_(0) {
+  for (size_t i = 0; i < max_size_; ++i)
+    StartWorker();
+
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&V8WorkerPool::OnMemoryPressure,
+        base::Unretained(this))));
+}
+
+V8WorkerPool::~V8WorkerPool() {
+  for (const Worker& worker : workers_)
+    StopWorker(worker);
+}
+
+bool V8WorkerPool::PostMessage(v8::Isolate* isolate,
+                               v8::Local<v8::Value> message,
+                               v8::Local<v8::Value> transfer_list) {
+  Worker* worker = GetLeastBusyWorker();
+  if (!worker)
+    return false;
+  if (!worker->queue_depth->IsZero() && workers_.size() < max_size_ &&
+      StartWorker())
+    worker = &workers_.back();
+
+  worker->queue_depth->Increment();
+  if (!WorkerBindings::OnMessage(isolate, worker->thread_id, message,
+          transfer_list,
+          base::Bind(&QueueDepth::Decrement, worker->queue_depth))) {
+    worker->queue_depth->Decrement();
+    return false;
+  }
+  return true;
+}
+
+std::vector<base::PlatformThreadId> V8WorkerPool::GetWorkerIds() const {
+  std::vector<base::PlatformThreadId> ids;
+  for (const Worker& worker : workers_)
+    ids.push_back(worker.thread_id);
+  return ids;
+}
+
+bool V8WorkerPool::StartWorker() {
+  std::string worker_name = module_name_ + "_pool_" + base::IntToString(id_) +
+      "_worker_" + base::IntToString(next_worker_index_++);
+  auto thread = new V8WorkerThread(worker_name, app_);
+  thread->set_pool_id(id_);
+  if (!thread->StartWithModule(module_name_)) {
+    delete thread;
+    return false;
+  }
+
+  Worker worker;
+  worker.thread_id = thread->GetThreadId();
+  worker.queue_depth = new QueueDepth;
+  workers_.push_back(worker);
+  return true;
+}
+
+void V8WorkerPool::StopWorker(const Worker& worker) {
+  // The thread deletes itself once it has shut down, so it is only ever
+  // referenced by id.
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      V8WorkerThread::GetTaskRunnerFor(worker.thread_id);
+  if (task_runner)
+    task_runner->PostTask(FROM_HERE, base::Bind(&V8WorkerThread::Shutdown));
+}
+
+V8WorkerPool::Worker* V8WorkerPool::GetLeastBusyWorker() {
+  if (workers_.empty() && !StartWorker())
+    return nullptr;
+
+  Worker* least_busy = &workers_.front();
+  for (Worker& worker : workers_) {
+    if (worker.queue_depth->Get() < least_busy->queue_depth->Get())
+      least_busy = &worker;
+  }
+  return least_busy;
+}
+
+void V8WorkerPool::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE ||
+      workers_.size() <= 1)
+    return;
+
+  // Keep one worker around so the pool stays responsive. The others are
+  // restarted by PostMessage when the remaining workers fall behind.
+  auto it = workers_.begin() + 1;
+  while (it != workers_.end()) {
+    if (it->queue_depth->IsZero()) {
+      StopWorker(*it);
+      it = workers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace brave
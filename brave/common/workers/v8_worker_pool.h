@@ -0,0 +1,97 @@
+// Copyright 2017 The Brave Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BRAVE_COMMON_WORKERS_V8_WORKER_POOL_H_
+#define BRAVE_COMMON_WORKERS_V8_WORKER_POOL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/atomic_ref_count.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/threading/platform_thread.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+namespace api {
+class App;
+}
+}
+
+namespace brave {
+
+// A set of V8WorkerThreads that all run the same module. Messages posted to
+// the pool go to the worker with the fewest messages still waiting to be
+// handled. Idle workers are stopped under memory pressure and started again
+// on demand when every remaining worker is busy.
+class V8WorkerPool {
+ public:
+  V8WorkerPool(int id,
+               const std::string& module_name,
+               size_t max_size,
+               atom::api::App* app);
+  ~V8WorkerPool();
+
+  bool PostMessage(v8::Isolate* isolate,
+                   v8::Local<v8::Value> message,
+                   v8::Local<v8::Value> transfer_list);
+
+  std::vector<base::PlatformThreadId> GetWorkerIds() const;
+
+  int id() const { return id_; }
+  size_t max_size() const { return max_size_; }
+
+ private:
+  // Number of messages posted to a worker that it hasn't handled yet. It is
+  // decremented on the worker thread, so it is shared with the message task.
+  class QueueDepth : public base::RefCountedThreadSafe<QueueDepth> {
+   public:
+    QueueDepth();
+
+    void Increment();
+    void Decrement();
+    bool IsZero() const;
+    int Get() const;
+
+   private:
+    friend class base::RefCountedThreadSafe<QueueDepth>;
+    ~QueueDepth();
+
+    base::AtomicRefCount count_;
+
+    DISALLOW_COPY_AND_ASSIGN(QueueDepth);
+  };
+
+  struct Worker {
+    base::PlatformThreadId thread_id;
+    scoped_refptr<QueueDepth> queue_depth;
+  };
+
+  bool StartWorker();
+  void StopWorker(const Worker& worker);
+  // Returns null if no worker could be started.
+  Worker* GetLeastBusyWorker();
+
+  void OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  const int id_;
+  const std::string module_name_;
+  const size_t max_size_;
+  atom::api::App* app_;  // not owned
+  // Gives each worker thread of the pool a distinct name.
+  int next_worker_index_;
+
+  std::vector<Worker> workers_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(V8WorkerPool);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMMON_WORKERS_V8_WORKER_POOL_H_
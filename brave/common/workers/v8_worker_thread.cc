@@ -5,9 +5,13 @@
 #include "brave/common/workers/v8_worker_thread.h"
 
 #include "atom/browser/api/atom_api_app.h"
+#include "atom/browser/idle_gc_scheduler.h"
 #include "atom/browser/javascript_environment.h"
+#include <map>
+
 #include "base/lazy_instance.h"
 #include "base/run_loop.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
 #include "brave/common/workers/worker_bindings.h"
 #include "content/child/worker_thread_registry.h"
@@ -23,6 +27,42 @@ namespace {
 base::LazyInstance<base::ThreadLocalPointer<V8WorkerThread>>::Leaky worker =
       LAZY_INSTANCE_INITIALIZER;
 
+// Task runners of the running workers. Unlike the WorkerThreadRegistry, a
+// worker is added as soon as it is started, so messages posted before it has
+// finished initializing are queued rather than dropped.
+class WorkerTaskRunners {
+ public:
+  WorkerTaskRunners() {}
+
+  scoped_refptr<base::SingleThreadTaskRunner> Get(
+      base::PlatformThreadId thread_id) {
+    base::AutoLock auto_lock(lock_);
+    auto it = task_runners_.find(thread_id);
+    return it == task_runners_.end() ? nullptr : it->second;
+  }
+
+  void Add(base::PlatformThreadId thread_id,
+           scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+    base::AutoLock auto_lock(lock_);
+    task_runners_[thread_id] = task_runner;
+  }
+
+  void Remove(base::PlatformThreadId thread_id) {
+    base::AutoLock auto_lock(lock_);
+    task_runners_.erase(thread_id);
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<base::PlatformThreadId,
+           scoped_refptr<base::SingleThreadTaskRunner>> task_runners_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerTaskRunners);
+};
+
+base::LazyInstance<WorkerTaskRunners>::Leaky g_task_runners =
+    LAZY_INSTANCE_INITIALIZER;
+
 void Kill(V8WorkerThread* worker) {
   delete worker;
 }
@@ -31,7 +71,8 @@ void Kill(V8WorkerThread* worker) {
 
 V8WorkerThread::V8WorkerThread(const std::string& name, atom::api::App* app) :
     base::Thread(name),
-    app_(app) {
+    app_(app),
+    pool_id_(-1) {
 }
 
 V8WorkerThread::~V8WorkerThread() {
@@ -43,6 +84,12 @@ V8WorkerThread* V8WorkerThread::current() {
   return worker.Get().Get();
 }
 
+// static
+scoped_refptr<base::SingleThreadTaskRunner> V8WorkerThread::GetTaskRunnerFor(
+    base::PlatformThreadId thread_id) {
+  return g_task_runners.Get().Get(thread_id);
+}
+
 // static
 void V8WorkerThread::Shutdown() {
   V8WorkerThread* instance = current();
@@ -55,10 +102,22 @@ void V8WorkerThread::Shutdown() {
                           base::Bind(&Kill, base::Unretained(instance)));
 }
 
+bool V8WorkerThread::StartWithModule(const std::string& module_name) {
+  if (!Start())
+    return false;
+
+  // The task runner takes tasks right away, they run once Init is done. Only
+  // the thread id is waited for, which is set before the thread initializes.
+  g_task_runners.Get().Add(GetThreadId(), task_runner());
+  Require(module_name);
+  return true;
+}
+
 void V8WorkerThread::Init() {
   worker.Get().Set(this);
 
   js_env_.reset(new atom::JavascriptEnvironment());
+  idle_gc_scheduler_.reset(new atom::IdleGCScheduler(env()->isolate()));
 
   env()->module_system()->RegisterNativeHandler(
       "worker", std::unique_ptr<extensions::NativeHandler>(
@@ -78,7 +137,9 @@ void V8WorkerThread::Run(base::RunLoop* run_loop) {
 // Called just after the message loop ends
 void V8WorkerThread::CleanUp() {
   content::WorkerThreadRegistry::Instance()->WillStopCurrentWorkerThread();
+  g_task_runners.Get().Remove(base::PlatformThread::CurrentId());
   memory_pressure_listener_.reset();
+  idle_gc_scheduler_.reset();
   env()->OnMessageLoopDestroying();
   js_env_.reset();
 
@@ -87,7 +148,7 @@ void V8WorkerThread::CleanUp() {
 
 void V8WorkerThread::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
-  env()->isolate()->LowMemoryNotification();
+  idle_gc_scheduler_->OnMemoryPressure(memory_pressure_level);
 }
 
 void V8WorkerThread::Require(const std::string& module_name) {
@@ -9,9 +9,13 @@
 #include <string>
 
 #include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/single_thread_task_runner.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/thread.h"
 
 namespace atom {
+class IdleGCScheduler;
 class JavascriptEnvironment;
 namespace api {
 class App;
@@ -28,6 +32,16 @@ class V8WorkerThread : public base::Thread {
   static V8WorkerThread* current();
   static void Shutdown();
 
+  // Returns the task runner of the worker running on |thread_id|, or null.
+  // Workers are found as soon as they are started, before their JavaScript
+  // environment is ready.
+  static scoped_refptr<base::SingleThreadTaskRunner> GetTaskRunnerFor(
+      base::PlatformThreadId thread_id);
+
+  // Starts the thread and requires |module_name| on it once it is ready,
+  // without waiting for it.
+  bool StartWithModule(const std::string& module_name);
+
   void Init() override;
   void Run(base::RunLoop* run_loop) override;
   void CleanUp() override;
@@ -36,13 +50,19 @@ class V8WorkerThread : public base::Thread {
 
   atom::api::App* app() const { return app_; }
   atom::JavascriptEnvironment* env() const { return js_env_.get(); }
+
+  // Id of the V8WorkerPool this worker belongs to, or -1.
+  int pool_id() const { return pool_id_; }
+  void set_pool_id(int pool_id) { pool_id_ = pool_id; }
  private:
   void RequireInThread(const std::string module_name);
   void OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
   atom::api::App* app_;
+  int pool_id_;
   std::unique_ptr<atom::JavascriptEnvironment> js_env_;
+  std::unique_ptr<atom::IdleGCScheduler> idle_gc_scheduler_;
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 };
 
@@ -2,33 +2,131 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <utility>
-
 #include "brave/common/workers/worker_bindings.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "atom/browser/api/atom_api_app.h"
 #include "brave/common/workers/v8_worker_thread.h"
-#include "content/child/worker_thread_registry.h"
 #include "content/public/browser/browser_thread.h"
 #include "extensions/renderer/script_context.h"
+#include "gin/array_buffer.h"
 #include "v8/include/v8.h"
 
 using content::BrowserThread;
 
 namespace brave {
 
+// A value serialized with v8::ValueSerializer together with the backing
+// stores of any ArrayBuffers that were transferred along with it. Backing
+// stores are handed to the receiving isolate without copying; anything not
+// picked up by Deserialize (e.g. the target worker is gone) is freed here.
+class SerializedMessage {
+ public:
+  SerializedMessage() : buffer_(nullptr, 0) {}
+
+  ~SerializedMessage() {
+    free(buffer_.first);
+    for (const v8::ArrayBuffer::Contents& contents : array_buffers_)
+      gin::ArrayBufferAllocator::SharedInstance()->Free(
+          contents.Data(), contents.ByteLength());
+  }
+
+  bool Serialize(v8::Isolate* isolate,
+                 v8::Local<v8::Value> message,
+                 v8::Local<v8::Value> transfer_list) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::ValueSerializer serializer(isolate);
+
+    std::vector<v8::Local<v8::ArrayBuffer>> transferred;
+    if (!transfer_list.IsEmpty() && !transfer_list->IsUndefined()) {
+      if (!transfer_list->IsArray()) {
+        isolate->ThrowException(v8::Exception::TypeError(
+            v8::String::NewFromUtf8(isolate,
+                                    "'transferList' must be an array")));
+        return false;
+      }
+      v8::Local<v8::Array> list = transfer_list.As<v8::Array>();
+      for (uint32_t i = 0; i < list->Length(); ++i) {
+        v8::Local<v8::Value> item;
+        if (!list->Get(context, i).ToLocal(&item))
+          return false;
+        if (!item->IsArrayBuffer() ||
+            !item.As<v8::ArrayBuffer>()->IsNeuterable() ||
+            std::find(transferred.begin(), transferred.end(), item) !=
+                transferred.end()) {
+          isolate->ThrowException(v8::Exception::TypeError(
+              v8::String::NewFromUtf8(isolate,
+                  "'transferList' may only contain distinct, "
+                  "transferable ArrayBuffers")));
+          return false;
+        }
+        v8::Local<v8::ArrayBuffer> array_buffer = item.As<v8::ArrayBuffer>();
+        serializer.TransferArrayBuffer(transferred.size(), array_buffer);
+        transferred.push_back(array_buffer);
+      }
+    }
+
+    serializer.WriteHeader();
+    if (!serializer.WriteValue(context, message).FromMaybe(false))
+      return false;
+    buffer_ = serializer.Release();
+
+    // Take over the backing stores and neuter the sender's buffers. Buffers
+    // that are already external belong to someone else (e.g. node), so those
+    // have to be copied once.
+    for (v8::Local<v8::ArrayBuffer> array_buffer : transferred) {
+      if (array_buffer->IsExternal()) {
+        v8::ArrayBuffer::Contents contents = array_buffer->GetContents();
+        void* data = gin::ArrayBufferAllocator::SharedInstance()->
+            AllocateUninitialized(contents.ByteLength());
+        memcpy(data, contents.Data(), contents.ByteLength());
+        array_buffers_.push_back(
+            v8::ArrayBuffer::Contents(data, contents.ByteLength()));
+      } else {
+        array_buffers_.push_back(array_buffer->Externalize());
+      }
+      array_buffer->Neuter();
+    }
+    return true;
+  }
+
+  bool Deserialize(v8::Isolate* isolate, v8::Local<v8::Value>* message) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::ValueDeserializer deserializer(
+        isolate, buffer_.first, buffer_.second);
+    deserializer.SetSupportsLegacyWireFormat(true);
+
+    for (size_t i = 0; i < array_buffers_.size(); ++i) {
+      deserializer.TransferArrayBuffer(i, v8::ArrayBuffer::New(isolate,
+          array_buffers_[i].Data(), array_buffers_[i].ByteLength(),
+          v8::ArrayBufferCreationMode::kInternalized));
+    }
+    // The receiving isolate owns the backing stores now.
+    array_buffers_.clear();
+
+    return deserializer.ReadHeader(context).FromMaybe(false) &&
+        deserializer.ReadValue(context).ToLocal(message);
+  }
+
+ private:
+  std::pair<uint8_t*, size_t> buffer_;
+  std::vector<v8::ArrayBuffer::Contents> array_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializedMessage);
+};
+
 namespace {
 
-void OnMessageInternal(const std::pair<uint8_t*, size_t>& buf) {
+void OnMessageInternal(std::unique_ptr<SerializedMessage> serialized,
+                       const base::Closure& done) {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::Local<v8::Context> context = isolate->GetCurrentContext();
 
-  v8::ValueDeserializer deserializer(
-      isolate, buf.first, buf.second);
-  deserializer.SetSupportsLegacyWireFormat(true);
-  if (deserializer.ReadHeader(context).FromMaybe(false)) {
-    v8::Local<v8::Value> message =
-        deserializer.ReadValue(context).ToLocalChecked();
+  v8::Local<v8::Value> message;
+  if (serialized->Deserialize(isolate, &message)) {
     v8::Local<v8::Object> global = context->Global();
     v8::Local<v8::Value> onmessage =
         global->Get(context, v8::String::NewFromUtf8(isolate, "onmessage",
@@ -42,7 +140,8 @@ void OnMessageInternal(const std::pair<uint8_t*, size_t>& buf) {
       (void)onmessage_fun->Call(context, global, 1, argv);
     }
   }
-  free(buf.first);
+  if (!done.is_null())
+    done.Run();
 }
 
 }  // namespace
@@ -58,19 +157,18 @@ WorkerBindings::WorkerBindings(extensions::ScriptContext* context,
 WorkerBindings::~WorkerBindings() {
 }
 
-void WorkerBindings::Emit(const std::pair<uint8_t*, size_t>& buf) {
-  v8::ValueDeserializer deserializer(
-      worker_->app()->isolate(), buf.first, buf.second);
-  deserializer.SetSupportsLegacyWireFormat(true);
-  if (deserializer.ReadHeader(
-      worker_->app()->isolate()->GetCurrentContext()).FromMaybe(false)) {
-    v8::Local<v8::Value> val = deserializer.ReadValue(
-        worker_->app()->isolate()->GetCurrentContext()).ToLocalChecked();
-    worker_->app()->Emit("worker-post-message", worker_->GetThreadId(), val);
+void WorkerBindings::Emit(std::unique_ptr<SerializedMessage> serialized) {
+  v8::Local<v8::Value> val;
+  if (serialized->Deserialize(worker_->app()->isolate(), &val)) {
+    if (worker_->pool_id() != -1) {
+      worker_->app()->Emit("worker-pool-post-message", worker_->pool_id(),
+                           worker_->GetThreadId(), val);
+    } else {
+      worker_->app()->Emit("worker-post-message", worker_->GetThreadId(), val);
+    }
   } else {
     worker_->app()->Emit("worker-post-message-failure", worker_->GetThreadId());
   }
-  free(buf.first);
 }
 
 void WorkerBindings::PostMessage(
@@ -81,43 +179,44 @@ void WorkerBindings::PostMessage(
     return;
   }
 
-  if (args.Length() > 1) {
-    context()->isolate()->ThrowException(v8::String::NewFromUtf8(
-        context()->isolate(), "'transferList' is not supported yet"));
-    return;
-  }
-
-  v8::ValueSerializer serializer(context()->isolate());
-  serializer.WriteHeader();
-  if (serializer.WriteValue(
-      context()->v8_context(), args[0]).FromMaybe(false)) {
-    std::pair<uint8_t*, size_t> buffer = serializer.Release();
-
+  v8::Context::Scope context_scope(context()->v8_context());
+  std::unique_ptr<SerializedMessage> serialized(new SerializedMessage);
+  if (serialized->Serialize(context()->isolate(), args[0], args[1])) {
     BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
       base::Bind(&WorkerBindings::Emit,
                   base::Unretained(this),
-                  std::move(buffer)));
+                  base::Passed(&serialized)));
   }
 }
 
 // static
-void WorkerBindings::OnMessage(v8::Isolate* isolate,
+bool WorkerBindings::OnMessage(v8::Isolate* isolate,
                                 base::PlatformThreadId thread_id,
-                                v8::Local<v8::Value> message) {
-  v8::ValueSerializer serializer(isolate);
-  serializer.WriteHeader();
-  if (serializer.WriteValue(
-      isolate->GetCurrentContext(), message).FromMaybe(false)) {
-    std::pair<uint8_t*, size_t> buffer = serializer.Release();
-
-    base::TaskRunner* task_runner =
-        content::WorkerThreadRegistry::Instance()->GetTaskRunnerFor(thread_id);
-    task_runner->PostTask(FROM_HERE,
-        base::Bind(&OnMessageInternal,
-        std::move(buffer)));
-    return true;
-  }
-  return false;
+                                v8::Local<v8::Value> message,
+                                v8::Local<v8::Value> transfer_list) {
+  return OnMessage(isolate, thread_id, message, transfer_list,
+                   base::Closure());
+}
+
+// static
+bool WorkerBindings::OnMessage(v8::Isolate* isolate,
+                                base::PlatformThreadId thread_id,
+                                v8::Local<v8::Value> message,
+                                v8::Local<v8::Value> transfer_list,
+                                const base::Closure& done) {
+  // Serializing neuters the transferred buffers, so the worker has to be
+  // looked up first.
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      V8WorkerThread::GetTaskRunnerFor(thread_id);
+  if (!task_runner)
+    return false;
+
+  std::unique_ptr<SerializedMessage> serialized(new SerializedMessage);
+  if (!serialized->Serialize(isolate, message, transfer_list))
+    return false;
+  return task_runner->PostTask(FROM_HERE,
+      base::Bind(&OnMessageInternal,
+      base::Passed(&serialized), done));
 }
 
 }  // namespace brave
@@ -5,8 +5,9 @@
 #ifndef BRAVE_COMMON_WORKERS_WORKER_BINDINGS_H_
 #define BRAVE_COMMON_WORKERS_WORKER_BINDINGS_H_
 
-#include <utility>
+#include <memory>
 
+#include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "extensions/renderer/object_backed_native_handler.h"
@@ -14,20 +15,32 @@
 
 namespace brave {
 
+class SerializedMessage;
 class V8WorkerThread;
 
 class WorkerBindings : public extensions::ObjectBackedNativeHandler {
  public:
   WorkerBindings(extensions::ScriptContext* context, V8WorkerThread* worker);
   ~WorkerBindings() override;
-  static void OnMessage(v8::Isolate* isolate,
+  // Posts |message| to the worker's onmessage handler. ArrayBuffers in
+  // |transfer_list| (an array, or empty/undefined for none) are moved to the
+  // worker and neutered in |isolate|.
+  static bool OnMessage(v8::Isolate* isolate,
                         base::PlatformThreadId thread_id,
-                        v8::Local<v8::Value> message);
+                        v8::Local<v8::Value> message,
+                        v8::Local<v8::Value> transfer_list);
+  // Same as above, running |done| on the worker thread once the message has
+  // been handled.
+  static bool OnMessage(v8::Isolate* isolate,
+                        base::PlatformThreadId thread_id,
+                        v8::Local<v8::Value> message,
+                        v8::Local<v8::Value> transfer_list,
+                        const base::Closure& done);
 
  private:
   void PostMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
 
-  void Emit(const std::pair<uint8_t*, size_t>& buffer);
+  void Emit(std::unique_ptr<SerializedMessage> serialized);
 
   V8WorkerThread* worker_;
   v8::Local<v8::Function> on_message_;
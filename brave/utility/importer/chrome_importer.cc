@@ -13,6 +13,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "brave/common/importer/imported_cookie_entry.h"
+#include "brave/common/importer/importer_constants.h"
 #include "build/build_config.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
 #include "chrome/common/importer/importer_bridge.h"
@@ -75,6 +76,7 @@ void ChromeImporter::ImportHistory() {
   sql::Statement s(db.GetUniqueStatement(query));
 
   std::vector<ImporterURLRow> rows;
+  rows.reserve(importer::kMaxItemsPerBatch);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -87,6 +89,10 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+    if (rows.size() >= importer::kMaxItemsPerBatch) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -227,6 +233,7 @@ void ChromeImporter::ImportCookies() {
   sql::Statement s(db.GetUniqueStatement(query));
 
   std::vector<ImportedCookieEntry> cookies;
+  cookies.reserve(importer::kMaxItemsPerBatch);
   while (s.Step() && !cancelled()) {
     ImportedCookieEntry cookie;
     base::string16 host(base::UTF8ToUTF16("*"));
@@ -242,6 +249,10 @@ void ChromeImporter::ImportCookies() {
     cookie.httponly = s.ColumnBool(6);
 
     cookies.push_back(cookie);
+    if (cookies.size() >= importer::kMaxItemsPerBatch) {
+      bridge_->SetCookies(cookies);
+      cookies.clear();
+    }
   }
 
   if (!cookies.empty() && !cancelled())
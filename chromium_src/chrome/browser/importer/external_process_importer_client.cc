@@ -4,15 +4,18 @@
 
 /**
  * This is not a straight copy from chromium src, in particular
- * we add SetCookies.
+ * we add SetCookies and write history and cookies in bounded batches.
  * This was originally forked with 52.0.2743.116.  Diff against
  * a version of that file for a full list of changes.
  */
 
 #include "chrome/browser/importer/external_process_importer_client.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/common/importer/importer_constants.h"
 #include "build/build_config.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/importer/external_process_importer_host.h"
@@ -175,7 +178,8 @@ void ExternalProcessImporterClient::OnHistoryImportStart(
     return;
 
   total_history_rows_count_ = total_history_rows_count;
-  history_rows_.reserve(total_history_rows_count);
+  history_rows_.reserve(
+      std::min(total_history_rows_count, importer::kMaxItemsPerBatch));
 }
 
 void ExternalProcessImporterClient::OnHistoryImportGroup(
@@ -186,9 +190,14 @@ void ExternalProcessImporterClient::OnHistoryImportGroup(
 
   history_rows_.insert(history_rows_.end(), history_rows_group.begin(),
                        history_rows_group.end());
-  if (history_rows_.size() >= total_history_rows_count_)
+  if (history_rows_.size() >= importer::kMaxItemsPerBatch ||
+      history_rows_.size() >= total_history_rows_count_) {
+    total_history_rows_count_ -=
+        std::min(history_rows_.size(), total_history_rows_count_);
     bridge_->SetHistoryItems(history_rows_,
                              static_cast<importer::VisitSource>(visit_source));
+    history_rows_.clear();
+  }
 }
 
 void ExternalProcessImporterClient::OnHomePageImportReady(
@@ -287,14 +296,16 @@ void ExternalProcessImporterClient::OnAutofillFormDataImportGroup(
   if (autofill_form_data_.size() >= total_autofill_form_data_entry_count_)
     bridge_->SetAutofillFormData(autofill_form_data_);
 }
+
 void ExternalProcessImporterClient::OnCookiesImportStart(
     size_t total_cookies_count) {
   if (cancelled_)
     return;
 
   total_cookies_count_ = total_cookies_count;
-  cookies_.reserve(total_cookies_count);
+  cookies_.reserve(std::min(total_cookies_count, importer::kMaxItemsPerBatch));
 }
+
 void ExternalProcessImporterClient::OnCookiesImportGroup(
     const std::vector<ImportedCookieEntry>& cookies_group) {
   if (cancelled_)
@@ -302,8 +313,12 @@ void ExternalProcessImporterClient::OnCookiesImportGroup(
 
   cookies_.insert(cookies_.end(), cookies_group.begin(),
                     cookies_group.end());
-  if (cookies_.size() >= total_cookies_count_)
+  if (cookies_.size() >= importer::kMaxItemsPerBatch ||
+      cookies_.size() >= total_cookies_count_) {
+    total_cookies_count_ -= std::min(cookies_.size(), total_cookies_count_);
     bridge_->SetCookies(cookies_);
+    cookies_.clear();
+  }
 }
 
 #if defined(OS_WIN)
@@ -4,7 +4,7 @@
 
 /**
  * This is not a straight copy from chromium src, in particular
- * we add SetCookies.
+ * we add SetCookies and write history and cookies in bounded batches.
  * This was originally forked with 52.0.2743.116.  Diff against
  * a version of that file for a full list of changes.
  */
@@ -127,6 +127,8 @@ class ExternalProcessImporterClient : public content::UtilityProcessHostClient {
 
   // These variables store data being collected from the importer until the
   // entire group has been collected and is ready to be written to the profile.
+  // History rows and cookies are flushed every importer::kMaxItemsPerBatch
+  // entries.
   std::vector<ImporterURLRow> history_rows_;
   std::vector<ImportedBookmarkEntry> bookmarks_;
   favicon_base::FaviconUsageDataList favicons_;
@@ -140,7 +142,7 @@ class ExternalProcessImporterClient : public content::UtilityProcessHostClient {
   // Total number of bookmarks to import.
   size_t total_bookmarks_count_;
 
-  // Total number of history items to import.
+  // Number of history items still expected for the current group.
   size_t total_history_rows_count_;
 
   // Total number of favicons to import.
@@ -149,7 +151,7 @@ class ExternalProcessImporterClient : public content::UtilityProcessHostClient {
   // Total number of autofill form data entries to import.
   size_t total_autofill_form_data_entry_count_;
 
-  // Total number of cookies to import.
+  // Number of cookies still expected for the current group.
   size_t total_cookies_count_;
 
   // Notifications received from the ProfileImportProcessHost are passed back
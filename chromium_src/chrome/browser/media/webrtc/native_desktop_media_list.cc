@@ -4,11 +4,13 @@
 
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <map>
 #include <set>
 #include <sstream>
 
-#include "base/hash.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
@@ -20,6 +22,7 @@
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_frame.h"
 #include "third_party/webrtc/modules/desktop_capture/desktop_capturer.h"
+#include "third_party/webrtc/modules/desktop_capture/desktop_region.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/gfx/skia_util.h"
 
@@ -31,11 +34,59 @@ namespace {
 // Update the list every second.
 const int kDefaultUpdatePeriod = 1000;
 
-// Returns a hash of a DesktopFrame content to detect when image for a desktop
-// media source has changed.
-uint32_t GetFrameHash(webrtc::DesktopFrame* frame) {
-  int data_size = frame->stride() * frame->size().height();
-  return base::SuperFastHash(reinterpret_cast<char*>(frame->data()), data_size);
+// A source that hasn't changed for a while is captured less often, skipping
+// up to this many refreshes in a row.
+const int kMaxRefreshesToSkip = 4;
+
+// Hashes one row of pixels. The lanes are independent so the compiler can
+// vectorize the loop.
+uint32_t HashRow(const uint8_t* row, size_t bytes) {
+  const size_t kLanes = 8;
+  const uint32_t kPrime = 16777619u;
+  uint32_t lanes[kLanes] = { 2166136261u, 2166136261u, 2166136261u,
+                             2166136261u, 2166136261u, 2166136261u,
+                             2166136261u, 2166136261u };
+  size_t words = bytes / sizeof(uint32_t);
+  size_t i = 0;
+  for (; i + kLanes <= words; i += kLanes) {
+    uint32_t values[kLanes];
+    memcpy(values, row + i * sizeof(uint32_t), sizeof(values));
+    for (size_t lane = 0; lane < kLanes; ++lane)
+      lanes[lane] = (lanes[lane] ^ values[lane]) * kPrime;
+  }
+  uint32_t hash = 0;
+  for (size_t lane = 0; lane < kLanes; ++lane)
+    hash = (hash ^ lanes[lane]) * kPrime;
+  for (size_t byte = i * sizeof(uint32_t); byte < bytes; ++byte)
+    hash = (hash ^ row[byte]) * kPrime;
+  return hash;
+}
+
+// Returns the frame rows ScaleDesktopFrame reads, in ascending order, so
+// that hashing them tells whether the thumbnail would change. Bilinear
+// scaling blends the two rows around the center of each thumbnail row. The
+// rows next to those are included as well, so the result doesn't depend on
+// how the scaler rounds.
+std::vector<int> GetSampledRows(const webrtc::DesktopSize& frame_size,
+                                const gfx::Size& thumbnail_size) {
+  int frame_height = frame_size.height();
+  int thumbnail_height = media::ComputeLetterboxRegion(
+      gfx::Rect(0, 0, thumbnail_size.width(), thumbnail_size.height()),
+      gfx::Size(frame_size.width(), frame_height)).height();
+
+  std::vector<int> rows;
+  for (int y = 0; y < thumbnail_height; ++y) {
+    int center = static_cast<int>(
+        (2 * y + 1) * static_cast<int64_t>(frame_height) /
+        (2 * thumbnail_height));
+    int first_row = std::max(center - 2, 0);
+    if (!rows.empty())
+      first_row = std::max(first_row, rows.back() + 1);
+    for (int row = first_row; row <= std::min(center + 2, frame_height - 1);
+         ++row)
+      rows.push_back(row);
+  }
+  return rows;
 }
 
 gfx::ImageSkia ScaleDesktopFrame(std::unique_ptr<webrtc::DesktopFrame> frame,
@@ -93,7 +144,29 @@ class NativeDesktopMediaList::Worker
                content::DesktopMediaID::Id view_dialog_id);
 
  private:
-  typedef std::map<DesktopMediaID, uint32> ImageHashesMap;
+  // What we know about a source from its previous captures.
+  struct SourceState {
+    SourceState();
+    ~SourceState();
+
+    webrtc::DesktopSize frame_size;
+    // The rows the thumbnail is scaled from, and their hashes in the last
+    // captured frame.
+    std::vector<int> rows;
+    std::vector<uint32_t> row_hashes;
+    // Consecutive captures that found no change.
+    int unchanged_captures;
+    int refreshes_to_skip;
+  };
+  typedef std::map<DesktopMediaID, SourceState> SourceStatesMap;
+
+  // Updates |state| for |frame| and returns whether the frame changed. When
+  // |use_damage| is set, only the rows in the frame's updated region are
+  // hashed again.
+  static bool UpdateSourceState(const webrtc::DesktopFrame& frame,
+                                const gfx::Size& thumbnail_size,
+                                bool use_damage,
+                                SourceState* state);
 
   // webrtc::DesktopCapturer::Callback interface.
   void OnCaptureResult(webrtc::DesktopCapturer::Result result,
@@ -106,7 +179,13 @@ class NativeDesktopMediaList::Worker
 
   std::unique_ptr<webrtc::DesktopFrame> current_frame_;
 
-  ImageHashesMap image_hashes_;
+  SourceStatesMap source_states_;
+
+  // Last source captured by each capturer. A frame's updated region is only
+  // relative to the capturer's previous frame, so it is only used when that
+  // frame was of the same source.
+  DesktopMediaID last_screen_id_;
+  DesktopMediaID last_window_id_;
 
   DISALLOW_COPY_AND_ASSIGN(Worker);
 };
@@ -126,6 +205,54 @@ NativeDesktopMediaList::Worker::Worker(
 
 NativeDesktopMediaList::Worker::~Worker() {}
 
+NativeDesktopMediaList::Worker::SourceState::SourceState()
+    : unchanged_captures(0),
+      refreshes_to_skip(0) {
+}
+
+NativeDesktopMediaList::Worker::SourceState::~SourceState() {}
+
+// static
+bool NativeDesktopMediaList::Worker::UpdateSourceState(
+    const webrtc::DesktopFrame& frame,
+    const gfx::Size& thumbnail_size,
+    bool use_damage,
+    SourceState* state) {
+  std::vector<int> rows = GetSampledRows(frame.size(), thumbnail_size);
+  size_t row_bytes =
+      frame.size().width() * webrtc::DesktopFrame::kBytesPerPixel;
+
+  if (!use_damage || !state->frame_size.equals(frame.size()) ||
+      state->rows != rows) {
+    std::vector<uint32_t> row_hashes(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+      row_hashes[i] = HashRow(frame.data() + rows[i] * frame.stride(),
+                              row_bytes);
+    bool changed = !state->frame_size.equals(frame.size()) ||
+        state->row_hashes != row_hashes;
+    state->frame_size = frame.size();
+    state->rows.swap(rows);
+    state->row_hashes.swap(row_hashes);
+    return changed;
+  }
+
+  bool changed = false;
+  for (webrtc::DesktopRegion::Iterator it(frame.updated_region());
+       !it.IsAtEnd(); it.Advance()) {
+    for (auto row = std::lower_bound(state->rows.begin(), state->rows.end(),
+                                     it.rect().top());
+         row != state->rows.end() && *row < it.rect().bottom(); ++row) {
+      size_t i = row - state->rows.begin();
+      uint32_t hash = HashRow(frame.data() + *row * frame.stride(), row_bytes);
+      if (state->row_hashes[i] != hash) {
+        state->row_hashes[i] = hash;
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
 void NativeDesktopMediaList::Worker::Refresh(
     const gfx::Size& thumbnail_size,
     content::DesktopMediaID::Id view_dialog_id) {
@@ -168,22 +295,38 @@ void NativeDesktopMediaList::Worker::Refresh(
       base::Bind(&NativeDesktopMediaList::OnSourcesList,
                  media_list_, sources));
 
-  ImageHashesMap new_image_hashes;
+  SourceStatesMap new_source_states;
 
   // Get a thumbnail for each source.
   for (size_t i = 0; i < sources.size(); ++i) {
     SourceDescription& source = sources[i];
+    SourceState& state = new_source_states[source.id];
+    SourceStatesMap::iterator it = source_states_.find(source.id);
+    if (it != source_states_.end())
+      state = it->second;
+
+    // Sources that haven't changed lately are captured less often.
+    if (state.refreshes_to_skip > 0) {
+      --state.refreshes_to_skip;
+      continue;
+    }
+
+    bool use_damage = false;
     switch (source.id.type) {
       case DesktopMediaID::TYPE_SCREEN:
         if (!screen_capturer_->SelectSource(source.id.id))
           continue;
         screen_capturer_->CaptureFrame();
+        use_damage = last_screen_id_ == source.id;
+        last_screen_id_ = source.id;
         break;
 
       case DesktopMediaID::TYPE_WINDOW:
         if (!window_capturer_->SelectSource(source.id.id))
           continue;
         window_capturer_->CaptureFrame();
+        use_damage = last_window_id_ == source.id;
+        last_window_id_ = source.id;
         break;
 
       default:
@@ -194,23 +337,27 @@ void NativeDesktopMediaList::Worker::Refresh(
     // |current_frame_| may be NULL if capture failed (e.g. because window has
     // been closed).
     if (current_frame_) {
-      uint32_t frame_hash = GetFrameHash(current_frame_.get());
-      new_image_hashes[source.id] = frame_hash;
+      bool changed = UpdateSourceState(*current_frame_, thumbnail_size,
+                                       use_damage, &state);
+      if (!changed) {
+        ++state.unchanged_captures;
+        state.refreshes_to_skip =
+            std::min(state.unchanged_captures, kMaxRefreshesToSkip);
+        continue;
+      }
+      state.unchanged_captures = 0;
 
       // Scale the image only if it has changed.
-      ImageHashesMap::iterator it = image_hashes_.find(source.id);
-      if (it == image_hashes_.end() || it->second != frame_hash) {
-        gfx::ImageSkia thumbnail =
-            ScaleDesktopFrame(std::move(current_frame_), thumbnail_size);
-        BrowserThread::PostTask(
-            BrowserThread::UI, FROM_HERE,
-            base::Bind(&NativeDesktopMediaList::OnSourceThumbnail,
-                        media_list_, i, thumbnail));
-      }
+      gfx::ImageSkia thumbnail =
+          ScaleDesktopFrame(std::move(current_frame_), thumbnail_size);
+      BrowserThread::PostTask(
+          BrowserThread::UI, FROM_HERE,
+          base::Bind(&NativeDesktopMediaList::OnSourceThumbnail,
+                      media_list_, i, thumbnail));
     }
   }
 
-  image_hashes_.swap(new_image_hashes);
+  source_states_.swap(new_source_states);
 
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE,
@@ -88,6 +88,18 @@ class ProcessSingleton : public base::NonThreadSafe {
 
 #if defined(OS_POSIX) && !defined(OS_ANDROID)
   static void DisablePromptForTesting();
+
+  // Lets later instances forward their command line through
+  // NotifyRunningInstance(). Must be called after Create() succeeded.
+  void EnableFastPath();
+
+  // Forwards the command line of the current process to the instance running
+  // with |user_data_dir|, if it called EnableFastPath(). Only needs the
+  // command line and the current directory, so it can run before the browser
+  // is initialized. Returns true if the other instance handled the command
+  // line. Unlike NotifyOtherProcess(), it never retries or kills a hung
+  // instance; callers fall back to the normal startup instead.
+  static bool NotifyRunningInstance(const base::FilePath& user_data_dir);
 #endif
 #if defined(OS_WIN)
   // Called to query whether to kill a hung browser process that has visible
@@ -166,6 +178,9 @@ class ProcessSingleton : public base::NonThreadSafe {
   // Path in file system to the cookie file.
   base::FilePath cookie_path_;
 
+  // Path in file system to the file that marks the fast path as enabled.
+  base::FilePath fast_path_path_;
+
   // Temporary directory to hold the socket.
   base::ScopedTempDir socket_dir_;
 
@@ -112,6 +112,8 @@ const base::FilePath::CharType kSingletonCookieFilename[] =
 const base::FilePath::CharType kSingletonLockFilename[] = FILE_PATH_LITERAL("SingletonLock");
 const base::FilePath::CharType kSingletonSocketFilename[] =
       FILE_PATH_LITERAL("SS");
+const base::FilePath::CharType kSingletonFastPathFilename[] =
+      FILE_PATH_LITERAL("SingletonFastPath");
 
 // Set the close-on-exec bit on a file descriptor.
 // Returns 0 on success, -1 on failure.
@@ -396,6 +398,20 @@ bool ConnectSocket(ScopedSocket* socket,
   }
 }
 
+// Formats the message sent to the other process:
+// "START\0<current dir>\0<argv[0]>\0...\0<argv[n]>".
+std::string FormatStartMessage(const base::FilePath& current_dir) {
+  std::string message(kStartToken);
+  message.push_back(kTokenDelimiter);
+  message.append(current_dir.value());
+
+  for (const std::string& arg : atom::AtomCommandLine::argv()) {
+    message.push_back(kTokenDelimiter);
+    message.append(arg);
+  }
+  return message;
+}
+
 #if defined(OS_MACOSX)
 bool ReplaceOldSingletonLock(const base::FilePath& symlink_content,
                              const base::FilePath& lock_path) {
@@ -722,6 +738,7 @@ ProcessSingleton::ProcessSingleton(
   socket_path_ = user_data_dir.Append(kSingletonSocketFilename);
   lock_path_ = user_data_dir.Append(kSingletonLockFilename);
   cookie_path_ = user_data_dir.Append(kSingletonCookieFilename);
+  fast_path_path_ = user_data_dir.Append(kSingletonFastPathFilename);
 
   kill_callback_ = base::Bind(&ProcessSingleton::KillProcess,
                               base::Unretained(this));
@@ -810,22 +827,11 @@ ProcessSingleton::NotifyResult ProcessSingleton::NotifyOtherProcessWithTimeout(
              &socket_timeout,
              sizeof(socket_timeout));
 
-  // Found another process, prepare our command line
-  // format is "START\0<current dir>\0<argv[0]>\0...\0<argv[n]>".
-  std::string to_send(kStartToken);
-  to_send.push_back(kTokenDelimiter);
-
+  // Found another process, prepare our command line.
   base::FilePath current_dir;
   if (!PathService::Get(base::DIR_CURRENT, &current_dir))
     return PROCESS_NONE;
-  to_send.append(current_dir.value());
-
-  const std::vector<std::string>& argv = atom::AtomCommandLine::argv();
-  for (std::vector<std::string>::const_iterator it = argv.begin();
-      it != argv.end(); ++it) {
-    to_send.push_back(kTokenDelimiter);
-    to_send.append(*it);
-  }
+  std::string to_send = FormatStartMessage(current_dir);
 
   // Send the message
   if (!WriteToSocket(socket.fd(), to_send.data(), to_send.length())) {
@@ -913,6 +919,52 @@ void ProcessSingleton::DisablePromptForTesting() {
   g_disable_prompt = true;
 }
 
+void ProcessSingleton::EnableFastPath() {
+  // The marker points at the cookie of this instance, so a marker left behind
+  // by an instance that crashed is ignored.
+  base::FilePath cookie = ReadLink(cookie_path_);
+  if (cookie.empty() || !SymlinkPath(cookie, fast_path_path_))
+    LOG(ERROR) << "Failed to enable the process singleton fast path.";
+}
+
+// static
+bool ProcessSingleton::NotifyRunningInstance(
+    const base::FilePath& user_data_dir) {
+  base::FilePath socket_path = user_data_dir.Append(kSingletonSocketFilename);
+  base::FilePath cookie_path = user_data_dir.Append(kSingletonCookieFilename);
+  base::FilePath cookie = ReadLink(cookie_path);
+  if (cookie.empty() ||
+      !CheckCookie(user_data_dir.Append(kSingletonFastPathFilename), cookie))
+    return false;
+
+  ScopedSocket socket;
+  if (!ConnectSocket(&socket, socket_path, cookie_path))
+    return false;
+
+  base::TimeDelta timeout = base::TimeDelta::FromSeconds(kTimeoutInSeconds);
+  timeval socket_timeout = TimeDeltaToTimeVal(timeout);
+  setsockopt(socket.fd(), SOL_SOCKET, SO_SNDTIMEO, &socket_timeout,
+             sizeof(socket_timeout));
+
+  base::FilePath current_dir;
+  if (!base::GetCurrentDirectory(&current_dir))
+    return false;
+  std::string to_send = FormatStartMessage(current_dir);
+  if (!WriteToSocket(socket.fd(), to_send.data(), to_send.length()))
+    return false;
+  if (shutdown(socket.fd(), SHUT_WR) < 0)
+    PLOG(ERROR) << "shutdown() failed";
+
+  // Anything other than an ACK, including a SHUTDOWN from an instance that is
+  // quitting, means this process has to start up normally.
+  char buf[kMaxACKMessageLength + 1];
+  ssize_t len = ReadFromSocket(socket.fd(), buf, kMaxACKMessageLength, timeout);
+  if (len <= 0)
+    return false;
+  buf[len] = '\0';
+  return strncmp(buf, kACKToken, arraysize(kACKToken) - 1) == 0;
+}
+
 bool ProcessSingleton::Create() {
   int sock;
   sockaddr_un addr;
@@ -981,6 +1033,7 @@ bool ProcessSingleton::Create() {
       socket_dir_.GetPath().Append(kSingletonCookieFilename);
   UnlinkPath(socket_path_);
   UnlinkPath(cookie_path_);
+  UnlinkPath(fast_path_path_);
   if (!SymlinkPath(socket_target_path, socket_path_) ||
       !SymlinkPath(cookie, cookie_path_) ||
       !SymlinkPath(cookie, remote_cookie_path)) {
@@ -1017,6 +1070,7 @@ bool ProcessSingleton::Create() {
 }
 
 void ProcessSingleton::Cleanup() {
+  UnlinkPath(fast_path_path_);
   UnlinkPath(socket_path_);
   UnlinkPath(cookie_path_);
   UnlinkPath(lock_path_);
@@ -62,8 +62,8 @@ app.postMessage = function (message) {
 app.startWorker = function (module_name) {
   const id = app._startWorker(module_name)
   const worker = {
-    postMessage: (message) => {
-      app._postMessage(id, message)
+    postMessage: (message, transferList) => {
+      app._postMessage(id, message, transferList)
     },
     terminate: () => {
       app.stopWorker(id)
@@ -76,6 +76,23 @@ app.startWorker = function (module_name) {
   return worker
 }
 
+app.startWorkerPool = function (moduleName, options = {}) {
+  const id = app._startWorkerPool(moduleName, options.size || 0)
+  const pool = {
+    postMessage: (message, transferList) => {
+      return app._postMessageToWorkerPool(id, message, transferList)
+    },
+    terminate: () => {
+      app.stopWorkerPool(id)
+    },
+    getWorkerIds: () => {
+      return app._getWorkerPoolIds(id)
+    },
+    id
+  }
+  return pool
+}
+
 app.allowNTLMCredentialsForAllDomains = function (allow) {
   if (!process.noDeprecations) {
     deprecate.warn('app.allowNTLMCredentialsForAllDomains', 'session.allowNTLMCredentialsForDomains')
@@ -14,18 +14,6 @@ var tabs = {}
 
 const TAB_ID_NONE = -1
 
-function debounce (fn, bufferInterval, ...args) {
-  let timeout
-  return (...args2) => {
-    clearTimeout(timeout)
-    let a = args || []
-    if (args2 && args2.constructor === Array) {
-      a = a.concat(args2)
-    }
-    timeout = setTimeout(fn.apply.bind(fn, this, a), bufferInterval)
-  }
-}
-
 var getResourceURL = function (extensionId, path) {
   path = String(path)
   if (!path.length || path[0] != '/')
@@ -276,35 +264,21 @@ const updateTab = function (tabId, updateProperties) {
     tabContents.setActive(true)
 }
 
-const chromeTabsUpdated = function (tabId) {
+// changeInfo only contains the fields that changed, as computed natively
+const chromeTabsUpdated = function (tabId, changeInfo, tabValue) {
   const tab = tabs[tabId]
-  if (!tab) {
-    return
-  }
-
-  let oldTabInfo = tab.tabValue
-  if (!oldTabInfo) {
+  if (!tab || !tab.tabValue) {
     return
   }
 
-  let tabValue = getTabValue(tabId)
-  tabs[tabId].tabValue = tabValue
-  let changeInfo = {}
-
-  for (var key in tabValue) {
-    if (tabValue[key] !== oldTabInfo[key]) {
-      changeInfo[key] = tabValue[key]
-    }
-  }
+  tab.tabValue = tabValue
 
-  if (Object.keys(changeInfo).length > 0) {
-    if (changeInfo.active) {
-      sendToBackgroundPages('all', getSessionForTab(tabId), 'chrome-tabs-activated', tabId, {tabId: tabId, windowId: tabValue.windowId})
-      process.emit('chrome-tabs-activated', tabId, {tabId: tabId, windowId: tabValue.windowId})
-    }
-    sendToBackgroundPages('all', getSessionForTab(tabId), 'chrome-tabs-updated', tabId, changeInfo, tabValue)
-    process.emit('chrome-tabs-updated', tabId, changeInfo, tabValue)
+  if (changeInfo.active) {
+    sendToBackgroundPages('all', getSessionForTab(tabId), 'chrome-tabs-activated', tabId, {tabId: tabId, windowId: tabValue.windowId})
+    process.emit('chrome-tabs-activated', tabId, {tabId: tabId, windowId: tabValue.windowId})
   }
+  sendToBackgroundPages('all', getSessionForTab(tabId), 'chrome-tabs-updated', tabId, changeInfo, tabValue)
+  process.emit('chrome-tabs-updated', tabId, changeInfo, tabValue)
 }
 
 const chromeTabsRemoved = function (tabId) {
@@ -334,11 +308,24 @@ const tabsQuery = function (queryInfo, useCurrentWindowId = false) {
     }
   }
 
+  // narrow the candidates down with the native window and active tab indexes
+  if (typeof queryInfo.windowId === 'number' && queryInfo.windowId >= 0) {
+    let activeTabId = queryInfo.active === true
+      ? webContents.getActiveTabIDForWindow(queryInfo.windowId) : undefined
+    let windowTabIds = webContents.getTabIDsForWindow(queryInfo.windowId)
+    if (activeTabId !== undefined) {
+      tabIds = activeTabId === -1 ? [] : [activeTabId]
+    } else if (windowTabIds) {
+      tabIds = windowTabIds
+    }
+    tabIds = tabIds.filter((tabId) => tabs[tabId])
+  }
+
   var queryKeys = Object.keys(queryInfo)
-  // get the values for all tabs
-  var tabValues = tabIds.reduce((tabs, tabId) => {
-    tabs[tabId] = getTabValue(tabId) || {}
-    return tabs
+  // the cached values are kept up to date by tab-value-changed
+  var tabValues = tabIds.reduce((values, tabId) => {
+    values[tabId] = tabs[tabId].tabValue || {}
+    return values
   }, {})
 
   var result = []
@@ -362,56 +349,25 @@ app.on('web-contents-created', function (event, tab) {
   if (tabId === -1)
     return
 
-  const updateTabDebounce = debounce(chromeTabsUpdated, 5)
-
-  tab.on('page-title-updated', function () {
-    updateTabDebounce(tabId)
-  })
-  tab.on('did-fail-load', function () {
-    updateTabDebounce(tabId)
-  })
-  tab.on('did-fail-provisional-load', function () {
-    updateTabDebounce(tabId)
+  tab.on('tab-value-changed', function (evt, changeInfo, tabValue) {
+    chromeTabsUpdated(tabId, changeInfo, tabValue)
   })
   tab.on('did-attach', function () {
     createTabValue(tab)
-    chromeTabsUpdated(tabId)  // immediate
-  })
-  tab.on('did-detach', () => {
-    chromeTabsUpdated(tabId)  // immediate
-  })
-  tab.on('did-start-loading', function () {
-    updateTabDebounce(tabId)
-  })
-  tab.on('did-stop-loading', function () {
-    updateTabDebounce(tabId)
   })
   tab.on('navigation-entry-commited', function (evt, url) {
     createTabValue(tab)
-    updateTabDebounce(tabId)
   })
   tab.on('did-navigate', function (evt, url) {
     createTabValue(tab)
-    chromeTabsUpdated(tabId)  // immediate
-  })
-  tab.on('did-navigate-in-page', function (evt, url, isMainFrame) {
-    updateTabDebounce(tabId)
   })
   tab.on('load-start', function (evt, url, isMainFrame, isErrorPage) {
     if (isMainFrame) {
       createTabValue(tab)
-      chromeTabsUpdated(tabId)  // immediate
     }
   })
   tab.on('did-finish-load', function () {
     createTabValue(tab)
-    updateTabDebounce(tabId)
-  })
-  tab.on('set-active', function (evt, active) {
-    chromeTabsUpdated(tabId)  // immediate
-  })
-  tab.on('set-tab-index', function (evt, index) {
-    updateTabDebounce(tabId)
   })
   tab.on('destroyed', function () {
     chromeTabsRemoved(tabId)
@@ -1,6 +1,6 @@
 const {EventEmitter} = require('events')
 const {app} = require('electron')
-const {fromPartition, Session} = process.atomBinding('session')
+const {fromPartition, fromPartitionAsync, Session} = process.atomBinding('session')
 
 // Public API.
 Object.defineProperties(exports, {
@@ -11,6 +11,16 @@ Object.defineProperties(exports, {
   fromPartition: {
     enumerable: true,
     value: fromPartition
+  },
+  fromPartitionAsync: {
+    enumerable: true,
+    value (partition, options, callback) {
+      if (typeof options === 'function') {
+        callback = options
+        options = {}
+      }
+      fromPartitionAsync(partition, options, callback)
+    }
   }
 })
 
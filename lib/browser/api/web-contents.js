@@ -164,6 +164,13 @@ WebContents.prototype._init = function () {
   this.on('ipc-message', function (event, [channel, ...args]) {
     ipcMain.emit(channel, event, ...args)
   })
+  // Batches have their own event so that listeners of the channel itself
+  // always get the arguments of a single message.
+  this.on('ipc-message-batch', function (event, batch) {
+    for (const [channel, ...messages] of batch) {
+      ipcMain.emit(`${channel}:batch`, event, messages)
+    }
+  })
   this.on('ipc-message-sync', function (event, [channel, ...args]) {
     Object.defineProperty(event, 'returnValue', {
       set: function (value) {
@@ -218,6 +225,23 @@ module.exports = {
     return binding.fromTabID(tabID)
   },
 
+  setMaxLiveTabs (count) {
+    if (binding.setMaxLiveTabs)
+      binding.setMaxLiveTabs(count)
+  },
+
+  getTabIDsForWindow (windowId) {
+    if (!binding.getTabIDsForWindow)
+      return
+    return binding.getTabIDsForWindow(windowId)
+  },
+
+  getActiveTabIDForWindow (windowId) {
+    if (!binding.getActiveTabIDForWindow)
+      return
+    return binding.getActiveTabIDForWindow(windowId)
+  },
+
   getFocusedWebContents () {
     let focused = null
     for (let contents of binding.getAllWebContents()) {
@@ -232,5 +256,9 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  getAllWebContentsInfo (options) {
+    return binding.getAllWebContentsInfo(options)
   }
 }
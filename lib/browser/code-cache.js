@@ -0,0 +1,251 @@
+'use strict'
+
+// Keeps V8's compile cache for the modules loaded by the main process between
+// runs. Entries are keyed by a hash of the script source and stored in a
+// directory named after V8's cached data version tag, which covers the V8
+// version and the flags that affect code generation.
+
+const crypto = require('crypto')
+const fs = require('fs')
+const Module = require('module')
+const path = require('path')
+const vm = require('vm')
+const {app} = require('electron')
+
+const v8Util = process.atomBinding('v8_util')
+
+// Small scripts compile faster than their cache can be read.
+const kMinSourceLength = 1024
+
+// Entries are only written once startup is done, so writing doesn't compete
+// with loading the app.
+const kWriteDelayMs = 10 * 1000
+
+const kMaxEntries = 4096
+const kMaxTotalSize = 64 * 1024 * 1024
+
+let userDataPath = null
+let cacheRoot = null
+let cacheDir = null
+let storedKeys = new Set()
+const usedKeys = new Set()
+const pendingEntries = new Map()
+let writeTimer = null
+let waitingForReady = false
+
+const hashSource = function (source) {
+  return crypto.createHash('sha1').update(source).digest('hex')
+}
+
+// Apps commonly move userData from their main script, e.g. to use a profile
+// per release channel, which runs after the cache was installed. The cache
+// follows userData and never touches the directory it moved away from.
+const updateCacheDir = function () {
+  const userData = app.getPath('userData')
+  if (userData === userDataPath) return
+  userDataPath = userData
+  cacheRoot = path.join(userDataPath, 'Code Cache', 'js')
+  cacheDir = path.join(cacheRoot,
+                       v8Util.getCachedDataVersionTag().toString(16))
+  usedKeys.clear()
+  try {
+    storedKeys = new Set(fs.readdirSync(cacheDir))
+  } catch (error) {
+    storedKeys = new Set()
+  }
+}
+
+const readEntry = function (key) {
+  updateCacheDir()
+  if (!storedKeys.has(key)) return undefined
+  try {
+    const data = fs.readFileSync(path.join(cacheDir, key))
+    usedKeys.add(key)
+    scheduleWrite()
+    return data
+  } catch (error) {
+    storedKeys.delete(key)
+    return undefined
+  }
+}
+
+const removeEntry = function (dir, key) {
+  if (dir === cacheDir) {
+    storedKeys.delete(key)
+    usedKeys.delete(key)
+  }
+  fs.unlink(path.join(dir, key), () => {})
+}
+
+const makeDirectory = function (dir) {
+  try {
+    fs.mkdirSync(dir)
+  } catch (error) {
+    if (error.code === 'ENOENT') {
+      makeDirectory(path.dirname(dir))
+      fs.mkdirSync(dir)
+    } else if (error.code !== 'EEXIST') {
+      throw error
+    }
+  }
+}
+
+const removeDirectory = function (dir) {
+  fs.readdir(dir, (error, names) => {
+    if (error) return
+    let remaining = names.length
+    const done = () => { fs.rmdir(dir, () => {}) }
+    if (remaining === 0) return done()
+    for (const name of names) {
+      fs.unlink(path.join(dir, name), () => {
+        if (--remaining === 0) done()
+      })
+    }
+  })
+}
+
+// Removes the caches of other V8 versions and flags.
+const removeStaleDirectories = function (root, current) {
+  fs.readdir(root, (error, names) => {
+    if (error) return
+    for (const name of names) {
+      const dir = path.join(root, name)
+      if (dir !== current) removeDirectory(dir)
+    }
+  })
+}
+
+// Drops the least recently used entries of |dir| once the cache is over its
+// limits, then calls |callback|. The entries are stat'ed asynchronously so
+// that large caches don't hold up the main process.
+const evictEntries = function (dir, callback) {
+  const keys = Array.from(storedKeys)
+  const entries = []
+  const now = Date.now()
+  let remaining = keys.length
+  if (remaining === 0) return callback()
+
+  const evict = function () {
+    let totalSize = entries.reduce((size, entry) => size + entry.size, 0)
+    if (entries.length > kMaxEntries || totalSize > kMaxTotalSize) {
+      entries.sort((a, b) => a.time - b.time)
+      for (const entry of entries) {
+        if (storedKeys.size <= kMaxEntries && totalSize <= kMaxTotalSize) break
+        removeEntry(dir, entry.key)
+        totalSize -= entry.size
+      }
+    }
+    callback()
+  }
+
+  for (const key of keys) {
+    fs.stat(path.join(dir, key), (error, stats) => {
+      if (error) {
+        storedKeys.delete(key)
+      } else {
+        const time = usedKeys.has(key) ? now : stats.mtime.getTime()
+        entries.push({key, size: stats.size, time})
+      }
+      if (--remaining === 0) evict()
+    })
+  }
+}
+
+const writeEntries = function () {
+  writeTimer = null
+  updateCacheDir()
+  const root = cacheRoot
+  const dir = cacheDir
+  try {
+    makeDirectory(dir)
+  } catch (error) {
+    return
+  }
+
+  // Evicting first means the new entries are never stat'ed before they are
+  // written.
+  evictEntries(dir, () => {
+    // userData moved while the entries were stat'ed.
+    if (dir !== cacheDir) return scheduleWrite()
+
+    // Entries read from the cache are touched so later evictions keep them.
+    const now = new Date()
+    for (const key of usedKeys) {
+      fs.utimes(path.join(dir, key), now, now, () => {})
+    }
+    usedKeys.clear()
+
+    for (const [key, data] of pendingEntries) {
+      storedKeys.add(key)
+      fs.writeFile(path.join(dir, key), data, (error) => {
+        if (error && dir === cacheDir) storedKeys.delete(key)
+      })
+    }
+    pendingEntries.clear()
+
+    removeStaleDirectories(root, dir)
+  })
+}
+
+const scheduleWrite = function () {
+  if (writeTimer != null) return
+  if (!app.isReady()) {
+    if (!waitingForReady) {
+      waitingForReady = true
+      app.once('ready', () => {
+        waitingForReady = false
+        scheduleWrite()
+      })
+    }
+    return
+  }
+  writeTimer = setTimeout(writeEntries, kWriteDelayMs)
+}
+
+const compileScript = function (code, options) {
+  const key = hashSource(code)
+  const cachedData = readEntry(key)
+  const script = new vm.Script(code, Object.assign({}, options, {
+    cachedData,
+    produceCachedData: cachedData == null
+  }))
+
+  if (cachedData != null) {
+    // The entry will be produced again on the next run.
+    if (script.cachedDataRejected) removeEntry(cacheDir, key)
+  } else if (script.cachedDataProduced) {
+    pendingEntries.set(key, script.cachedData)
+    scheduleWrite()
+  }
+  return script
+}
+
+exports.install = function () {
+  if (process.env.ELECTRON_DISABLE_CODE_CACHE) return
+
+  updateCacheDir()
+
+  // Module.prototype._compile compiles the module wrapper with
+  // vm.runInThisContext before it runs the module, so only that first call is
+  // taken over. Calls made by the module itself, and calls that bring their
+  // own cached data, are left alone.
+  const compile = Module.prototype._compile
+  const runInThisContext = vm.runInThisContext
+  const compileWrapper = function (code, options) {
+    vm.runInThisContext = runInThisContext
+    if (typeof code !== 'string' || code.length < kMinSourceLength ||
+        options == null || typeof options !== 'object' ||
+        options.cachedData != null || options.produceCachedData) {
+      return runInThisContext.apply(this, arguments)
+    }
+    return compileScript(code, options).runInThisContext(options)
+  }
+  Module.prototype._compile = function () {
+    vm.runInThisContext = compileWrapper
+    try {
+      return compile.apply(this, arguments)
+    } finally {
+      vm.runInThisContext = runInThisContext
+    }
+  }
+}
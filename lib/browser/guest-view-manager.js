@@ -49,7 +49,8 @@ let supportedWebViewEvents = [
   'hide-autofill-popup',
   'show-autofill-popup',
   'did-run-insecure-content',
-  'did-block-run-insecure-content'
+  'did-block-run-insecure-content',
+  'discarded'
 ]
 
 let guests = {}
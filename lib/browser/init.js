@@ -144,6 +144,9 @@ if (packageJson.v8Flags != null) {
 // Set the user path according to application's name.
 app.setAppPath(packagePath)
 
+// Use the compile cache for the modules loaded from here on.
+require('./code-cache').install()
+
 // Load the chrome extension support.
 require('./api/extensions')
 
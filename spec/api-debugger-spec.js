@@ -112,6 +112,51 @@ describe('debugger module', function () {
       w.webContents.debugger.sendCommand('Console.enable')
     })
 
+    it('only fires message events that pass the filter', function (done) {
+      w.webContents.loadURL('about:blank')
+      try {
+        w.webContents.debugger.attach()
+      } catch (err) {
+        done('unexpected error : ' + err)
+      }
+      w.webContents.debugger.setEventFilter(['Runtime.consoleAPICalled'])
+      w.webContents.debugger.on('message', function (e, method, params) {
+        assert.equal(method, 'Runtime.consoleAPICalled')
+        assert.equal(params.args[0].value, 'filtered')
+        w.webContents.debugger.detach()
+        done()
+      })
+      w.webContents.debugger.sendCommand('Runtime.enable', function () {
+        w.webContents.debugger.sendCommand('Runtime.evaluate', {
+          expression: 'console.log("filtered")'
+        })
+      })
+    })
+
+    it('fires message events with raw JSON', function (done) {
+      w.webContents.loadURL('about:blank')
+      try {
+        w.webContents.debugger.attach()
+      } catch (err) {
+        done('unexpected error : ' + err)
+      }
+      w.webContents.debugger.setEventFilter(['Runtime'])
+      w.webContents.debugger.setRawMessages(true)
+      w.webContents.debugger.on('message', function (e, method, message) {
+        if (method === 'Runtime.consoleAPICalled') {
+          assert.equal(typeof message, 'string')
+          assert.equal(JSON.parse(message).params.args[0].value, 'raw')
+          w.webContents.debugger.detach()
+          done()
+        }
+      })
+      w.webContents.debugger.sendCommand('Runtime.enable', function () {
+        w.webContents.debugger.sendCommand('Runtime.evaluate', {
+          expression: 'console.log("raw")'
+        })
+      })
+    })
+
     it('returns error message when command fails', function (done) {
       w.webContents.loadURL('about:blank')
       try {
@@ -485,6 +485,112 @@ describe('ipc module', function () {
     })
   })
 
+  describe('ipc batching', function () {
+    const url = 'file://' + path.join(fixtures, 'api', 'ipc-batch.html')
+
+    beforeEach(function () {
+      w = new BrowserWindow({
+        show: false
+      })
+    })
+
+    afterEach(function () {
+      ipcMain.removeAllListeners('batch-down-received')
+      ipcMain.removeAllListeners('batch-fast-received')
+      ipcMain.removeAllListeners('batch-up:batch')
+      ipcMain.removeAllListeners('batch-up')
+    })
+
+    it('emits the messages of a channel as <channel>:batch in the renderer', function (done) {
+      ipcMain.once('batch-down-received', function (event, messages) {
+        assert.deepEqual(messages, [[1], [2, 'two'], [3]])
+        done()
+      })
+      w.webContents.once('did-finish-load', function () {
+        w.webContents.setIPCBatching('batch-down', {})
+        w.webContents.send('batch-down', 1)
+        w.webContents.send('batch-down', 2, 'two')
+        w.webContents.send('batch-down', 3)
+      })
+      w.loadURL(url)
+    })
+
+    it('only sends the last message of a coalesced channel to the renderer', function (done) {
+      ipcMain.once('batch-down-received', function (event, messages) {
+        assert.deepEqual(messages, [[3]])
+        done()
+      })
+      w.webContents.once('did-finish-load', function () {
+        w.webContents.setIPCBatching('batch-down', {coalesce: true})
+        w.webContents.send('batch-down', 1)
+        w.webContents.send('batch-down', 2)
+        w.webContents.send('batch-down', 3)
+      })
+      w.loadURL(url)
+    })
+
+    it('sends the batch when the shortest interval is up', function (done) {
+      let start = null
+      ipcMain.once('batch-fast-received', function (event, messages) {
+        assert.deepEqual(messages, [[1]])
+        assert.ok(Date.now() - start < 500)
+        done()
+      })
+      w.webContents.once('did-finish-load', function () {
+        w.webContents.setIPCBatching('batch-down', {interval: 1000})
+        w.webContents.setIPCBatching('batch-fast', {interval: 0})
+        start = Date.now()
+        w.webContents.send('batch-down', 1)
+        w.webContents.send('batch-fast', 1)
+      })
+      w.loadURL(url)
+    })
+
+    it('drops the messages queued for the renderer on navigation', function (done) {
+      ipcMain.once('batch-down-received', function () {
+        done(new Error('batch was delivered to the new page'))
+      })
+      w.webContents.once('did-finish-load', function () {
+        w.webContents.setIPCBatching('batch-down', {interval: 1000})
+        w.webContents.send('batch-down', 1)
+        w.webContents.once('did-finish-load', function () {
+          setTimeout(done, 1500)
+        })
+        w.loadURL(url)
+      })
+      w.loadURL(url)
+    })
+
+    it('emits the messages of a channel as <channel>:batch in the main process', function (done) {
+      ipcMain.once('batch-up', function () {
+        done(new Error('batched message was emitted on its channel'))
+      })
+      ipcMain.once('batch-up:batch', function (event, messages) {
+        assert.deepEqual(messages, [[1], [2], [3]])
+        done()
+      })
+      w.loadURL(url + '#up')
+    })
+
+    it('only sends the last message of a coalesced channel to the main process', function (done) {
+      ipcMain.once('batch-up:batch', function (event, messages) {
+        assert.deepEqual(messages, [[3]])
+        done()
+      })
+      w.loadURL(url + '#up-coalesce')
+    })
+
+    it('drops the messages queued for the main process on navigation', function (done) {
+      ipcMain.once('batch-up:batch', function () {
+        done(new Error('batch was delivered after the page went away'))
+      })
+      w.webContents.on('did-navigate', function (event, url) {
+        if (url === 'about:blank') setTimeout(done, 1500)
+      })
+      w.loadURL(url + '#up-navigate')
+    })
+  })
+
   describe('remote listeners', function () {
     it('can be added and removed correctly', function () {
       w = new BrowserWindow({
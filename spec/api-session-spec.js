@@ -49,6 +49,47 @@ describe('session module', function () {
     })
   })
 
+  describe('session.fromPartitionAsync(partition, options, callback)', function () {
+    let partitionCount = 0
+    const newPartition = function () {
+      return 'persist:from-partition-async-' + Date.now() + '-' + partitionCount++
+    }
+
+    it('calls back with the session once it is loaded', function (done) {
+      const partition = newPartition()
+      session.fromPartitionAsync(partition, function (ses) {
+        assert.equal(ses, session.fromPartition(partition))
+        done()
+      })
+    })
+
+    it('makes session.fromPartition throw while the session loads', function (done) {
+      const partition = newPartition()
+      session.fromPartitionAsync(partition, function () {
+        assert.doesNotThrow(function () {
+          session.fromPartition(partition)
+        })
+        done()
+      })
+      assert.throws(function () {
+        session.fromPartition(partition)
+      }, /Session is still loading/)
+    })
+
+    it('makes BrowserWindow creation throw while the session loads', function (done) {
+      const partition = newPartition()
+      session.fromPartitionAsync(partition, function () {
+        done()
+      })
+      assert.throws(function () {
+        return new BrowserWindow({
+          show: false,
+          webPreferences: {partition}
+        })
+      }, /Session is still loading/)
+    })
+  })
+
   describe('ses.cookies', function () {
     it('should get cookies', function (done) {
       var server = http.createServer(function (req, res) {
@@ -48,6 +48,57 @@ describe('webContents module', function () {
     })
   })
 
+  describe('getAllWebContentsInfo() API', function () {
+    const findInfo = function (infos, contents) {
+      return infos.find((info) => info.id === contents.getId())
+    }
+
+    it('returns the default fields of every web contents', function () {
+      const info = findInfo(webContents.getAllWebContentsInfo(), w.webContents)
+      assert.deepEqual(Object.keys(info).sort(),
+                       ['id', 'isLoading', 'title', 'type', 'url'])
+      assert.equal(info.type, w.webContents.getType())
+      assert.equal(info.url, w.webContents.getURL())
+      assert.equal(info.title, w.webContents.getTitle())
+      assert.equal(info.isLoading, w.webContents.isLoading())
+    })
+
+    it('returns only the requested fields', function () {
+      const infos = webContents.getAllWebContentsInfo({
+        fields: ['id', 'isCrashed', 'ownerWindowId']
+      })
+      const info = findInfo(infos, w.webContents)
+      assert.deepEqual(Object.keys(info).sort(),
+                       ['id', 'isCrashed', 'ownerWindowId'])
+      assert.equal(info.isCrashed, false)
+      assert.equal(info.ownerWindowId, w.id)
+    })
+
+    it('only returns web contents of the given type', function () {
+      const infos = webContents.getAllWebContentsInfo({type: 'window'})
+      assert.ok(findInfo(infos, w.webContents))
+      for (const info of infos) {
+        assert.equal(info.type, 'window')
+      }
+      const remoteInfos = webContents.getAllWebContentsInfo({type: 'remote'})
+      assert.equal(findInfo(remoteInfos, w.webContents), undefined)
+    })
+
+    it('only returns web contents owned by the given window', function () {
+      const infos = webContents.getAllWebContentsInfo({
+        ownerWindowId: w.id,
+        fields: ['id', 'ownerWindowId']
+      })
+      assert.deepEqual(infos, [{id: w.webContents.getId(), ownerWindowId: w.id}])
+    })
+
+    it('throws for an unknown field', function () {
+      assert.throws(function () {
+        webContents.getAllWebContentsInfo({fields: ['id', 'notAField']})
+      }, /Unknown field: notAField/)
+    })
+  })
+
   describe('getFocusedWebContents() API', function () {
     it('returns the focused web contents', function (done) {
       if (isCi) return done()